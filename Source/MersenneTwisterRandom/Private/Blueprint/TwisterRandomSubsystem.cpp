@@ -7,6 +7,7 @@ void UTwisterRandomSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 	Random = RandomEngine(RandomEngine::StaticNewSeed());
+	Streams.SetRootSeed(Random.GetRootSeed());
 }
 
 float UTwisterRandomSubsystem::RandFloat(const float Min, const float Max)
@@ -124,11 +125,99 @@ int32 UTwisterRandomSubsystem::GetRootSeed() const
 void UTwisterRandomSubsystem::RerollSeed()
 {
 	Random = RandomEngine(RandomEngine::StaticNewSeed());
+	Streams.SetRootSeed(Random.GetRootSeed());
 }
 
 void UTwisterRandomSubsystem::SetSeed(const int32 InSeed)
 {
 	Random = RandomEngine(InSeed);
+	Streams.SetRootSeed(Random.GetRootSeed());
+}
+
+RandomEngine* UTwisterRandomSubsystem::FindStream(const FTwisterRandomStream& Stream, const TCHAR* Function)
+{
+	RandomEngine* Engine = Streams.Find(Stream.Index, Stream.Name, Stream.RegistryId);
+	if (!Engine)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UTwisterRandomSubsystem::%s - Stream handle '%s' was not resolved on this subsystem"), Function, *Stream.Name.ToString());
+	}
+	return Engine;
+}
+
+FTwisterRandomStream UTwisterRandomSubsystem::GetStream(const FName Name)
+{
+	FTwisterRandomStream Stream;
+	Stream.Name = Name;
+	Stream.Index = Streams.FindOrAdd(Name);
+	Stream.RegistryId = Streams.GetId();
+	return Stream;
+}
+
+RandomEngine& UTwisterRandomSubsystem::GetStreamEngine(const FName Name, const ERandomEngineBackend Backend)
+{
+	return Streams.Get(Streams.FindOrAdd(Name, Backend));
+}
+
+float UTwisterRandomSubsystem::StreamRandFloat(const FTwisterRandomStream& Stream, const float Min, const float Max)
+{
+	if (RandomEngine* Engine = FindStream(Stream, TEXT("StreamRandFloat")))
+	{
+		return Engine->RandFloat(Min, Max);
+	}
+	return 0.0f;
+}
+
+int32 UTwisterRandomSubsystem::StreamRandInt(const FTwisterRandomStream& Stream, const int32 Min, const int32 Max)
+{
+	if (RandomEngine* Engine = FindStream(Stream, TEXT("StreamRandInt")))
+	{
+		return Engine->RandInt(Min, Max);
+	}
+	return 0;
+}
+
+bool UTwisterRandomSubsystem::StreamRandBool(const FTwisterRandomStream& Stream, const float Probability)
+{
+	if (RandomEngine* Engine = FindStream(Stream, TEXT("StreamRandBool")))
+	{
+		return Engine->RandBool(Probability);
+	}
+	return false;
+}
+
+float UTwisterRandomSubsystem::StreamRandGaussian(const FTwisterRandomStream& Stream, const float Mean, const float StdDev)
+{
+	if (RandomEngine* Engine = FindStream(Stream, TEXT("StreamRandGaussian")))
+	{
+		return Engine->RandGaussian(Mean, StdDev);
+	}
+	return 0.0f;
+}
+
+int32 UTwisterRandomSubsystem::StreamRandWeighted(const FTwisterRandomStream& Stream, const TArray<float>& Weights)
+{
+	if (RandomEngine* Engine = FindStream(Stream, TEXT("StreamRandWeighted")))
+	{
+		return Engine->RandWeighted(Weights);
+	}
+	return -1;
+}
+
+int32 UTwisterRandomSubsystem::StreamGetCurrentState(const FTwisterRandomStream& Stream)
+{
+	if (const RandomEngine* Engine = FindStream(Stream, TEXT("StreamGetCurrentState")))
+	{
+		return static_cast<int32>(Engine->GetCurrentState());
+	}
+	return 0;
+}
+
+void UTwisterRandomSubsystem::StreamReset(const FTwisterRandomStream& Stream)
+{
+	if (RandomEngine* Engine = FindStream(Stream, TEXT("StreamReset")))
+	{
+		Engine->Reset();
+	}
 }
 
 int32 UTwisterRandomSubsystem::StaticNewSeed()
@@ -0,0 +1,189 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Blueprint/TwisterRandomWorldSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+bool UTwisterRandomWorldSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	// Editor preview worlds never simulate gameplay, they do not need their own streams
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UTwisterRandomWorldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	ReseedFromEngine();
+}
+
+int32 UTwisterRandomWorldSubsystem::StaticWorldSeed(const int32 EngineRootSeed, const UWorld& World, const bool bSeparatePIEInstances)
+{
+	// Without the UEDPIE_N_ prefix the same map seeds the same way in PIE, standalone and packaged runs
+	int32 PIEInstanceID = INDEX_NONE;
+	const FString MapName = UWorld::RemovePIEPrefix(World.GetOutermost()->GetName(), &PIEInstanceID);
+	const int32 MapSeed = RandomEngine::StaticDeriveSeed(EngineRootSeed, FName(*MapName));
+	if (bSeparatePIEInstances && PIEInstanceID != INDEX_NONE)
+	{
+		return RandomEngine::StaticDeriveSeed(MapSeed, static_cast<uint32>(PIEInstanceID));
+	}
+	return MapSeed;
+}
+
+int32 UTwisterRandomWorldSubsystem::GetRootSeed() const
+{
+	return Random.GetRootSeed();
+}
+
+void UTwisterRandomWorldSubsystem::SetSeed(const int32 InSeed)
+{
+	Random = RandomEngine(InSeed);
+	Streams.SetRootSeed(InSeed);
+}
+
+void UTwisterRandomWorldSubsystem::ReseedFromEngine(const bool bSeparatePIEInstances)
+{
+	const UTwisterRandomSubsystem* EngineRandom = GEngine ? GEngine->GetEngineSubsystem<UTwisterRandomSubsystem>() : nullptr;
+	const int32 EngineRootSeed = EngineRandom ? EngineRandom->GetRootSeed() : RandomEngine::StaticNewSeed();
+	SetSeed(StaticWorldSeed(EngineRootSeed, *GetWorld(), bSeparatePIEInstances));
+}
+
+float UTwisterRandomWorldSubsystem::RandFloat(const float Min, const float Max)
+{
+	return Random.RandFloat(Min, Max);
+}
+
+int32 UTwisterRandomWorldSubsystem::RandInt(const int32 Min, const int32 Max)
+{
+	return Random.RandInt(Min, Max);
+}
+
+bool UTwisterRandomWorldSubsystem::RandBool(const float Probability)
+{
+	return Random.RandBool(Probability);
+}
+
+float UTwisterRandomWorldSubsystem::RandGaussian(const float Mean, const float StdDev)
+{
+	return Random.RandGaussian(Mean, StdDev);
+}
+
+int32 UTwisterRandomWorldSubsystem::RandWeighted(const TArray<float>& Weights)
+{
+	return Random.RandWeighted(Weights);
+}
+
+int32 UTwisterRandomWorldSubsystem::GetCurrentState() const
+{
+	return static_cast<int32>(Random.GetCurrentState());
+}
+
+void UTwisterRandomWorldSubsystem::Reset()
+{
+	Random.Reset();
+	Streams.ResetAll();
+}
+
+RandomEngine* UTwisterRandomWorldSubsystem::FindStream(const FTwisterRandomStream& Stream, const TCHAR* Function)
+{
+	RandomEngine* Engine = Streams.Find(Stream.Index, Stream.Name, Stream.RegistryId);
+	if (!Engine)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UTwisterRandomWorldSubsystem::%s - Stream handle '%s' was not resolved on this subsystem"), Function, *Stream.Name.ToString());
+	}
+	return Engine;
+}
+
+FTwisterRandomStream UTwisterRandomWorldSubsystem::GetStream(const FName Name)
+{
+	FTwisterRandomStream Stream;
+	Stream.Name = Name;
+	Stream.Index = Streams.FindOrAdd(Name);
+	Stream.RegistryId = Streams.GetId();
+	return Stream;
+}
+
+RandomEngine& UTwisterRandomWorldSubsystem::GetStreamEngine(const FName Name, const ERandomEngineBackend Backend)
+{
+	return Streams.Get(Streams.FindOrAdd(Name, Backend));
+}
+
+float UTwisterRandomWorldSubsystem::StreamRandFloat(const FTwisterRandomStream& Stream, const float Min, const float Max)
+{
+	if (RandomEngine* Engine = FindStream(Stream, TEXT("StreamRandFloat")))
+	{
+		return Engine->RandFloat(Min, Max);
+	}
+	return 0.0f;
+}
+
+int32 UTwisterRandomWorldSubsystem::StreamRandInt(const FTwisterRandomStream& Stream, const int32 Min, const int32 Max)
+{
+	if (RandomEngine* Engine = FindStream(Stream, TEXT("StreamRandInt")))
+	{
+		return Engine->RandInt(Min, Max);
+	}
+	return 0;
+}
+
+bool UTwisterRandomWorldSubsystem::StreamRandBool(const FTwisterRandomStream& Stream, const float Probability)
+{
+	if (RandomEngine* Engine = FindStream(Stream, TEXT("StreamRandBool")))
+	{
+		return Engine->RandBool(Probability);
+	}
+	return false;
+}
+
+float UTwisterRandomWorldSubsystem::StreamRandGaussian(const FTwisterRandomStream& Stream, const float Mean, const float StdDev)
+{
+	if (RandomEngine* Engine = FindStream(Stream, TEXT("StreamRandGaussian")))
+	{
+		return Engine->RandGaussian(Mean, StdDev);
+	}
+	return 0.0f;
+}
+
+int32 UTwisterRandomWorldSubsystem::StreamRandWeighted(const FTwisterRandomStream& Stream, const TArray<float>& Weights)
+{
+	if (RandomEngine* Engine = FindStream(Stream, TEXT("StreamRandWeighted")))
+	{
+		return Engine->RandWeighted(Weights);
+	}
+	return -1;
+}
+
+int32 UTwisterRandomWorldSubsystem::StreamGetCurrentState(const FTwisterRandomStream& Stream)
+{
+	if (const RandomEngine* Engine = FindStream(Stream, TEXT("StreamGetCurrentState")))
+	{
+		return static_cast<int32>(Engine->GetCurrentState());
+	}
+	return 0;
+}
+
+void UTwisterRandomWorldSubsystem::StreamReset(const FTwisterRandomStream& Stream)
+{
+	if (RandomEngine* Engine = FindStream(Stream, TEXT("StreamReset")))
+	{
+		Engine->Reset();
+	}
+}
+
+FTwisterRandomWorldSnapshot UTwisterRandomWorldSubsystem::CaptureSnapshot() const
+{
+	FTwisterRandomWorldSnapshot Snapshot;
+	Snapshot.Random = Random;
+	Snapshot.Streams = Streams;
+	Snapshot.bIsValid = true;
+	return Snapshot;
+}
+
+void UTwisterRandomWorldSubsystem::RestoreSnapshot(const FTwisterRandomWorldSnapshot& Snapshot)
+{
+	if (Snapshot.bIsValid)
+	{
+		Random = Snapshot.Random;
+		Streams = Snapshot.Streams;
+	}
+}
@@ -1,6 +1,7 @@
 ﻿// Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "MersenneTwisterRandom.h"
+#include "System/RandomCurveSampler.h"
 
 #define LOCTEXT_NAMESPACE "FMersenneTwisterRandomModule"
 
@@ -8,12 +9,14 @@ void FMersenneTwisterRandomModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
 	//Engine = new RandomEngine(RandomEngine::StaticNewSeed());
+	RandomCurveSampler::RegisterCacheEvents();
 }
 
 void FMersenneTwisterRandomModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	RandomCurveSampler::UnregisterCacheEvents();
 }
 
 #undef LOCTEXT_NAMESPACE
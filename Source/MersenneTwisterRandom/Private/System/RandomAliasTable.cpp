@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "System/RandomAliasTable.h"
+
+RandomAliasTable::RandomAliasTable(TArrayView<const float> Weights)
+{
+	Build(Weights);
+}
+
+bool RandomAliasTable::Build(TArrayView<const float> Weights)
+{
+	Thresholds.Reset();
+	Aliases.Reset();
+	TotalWeight = 0.0;
+
+	for (const float Weight : Weights)
+	{
+		if (Weight > 0.0f)
+		{
+			TotalWeight += Weight;
+		}
+	}
+	if (TotalWeight <= 0.0)
+	{
+		return false;
+	}
+
+	// Scale weights so the average column holds exactly 1
+	const int32 Count = Weights.Num();
+	TArray<double> Scaled;
+	Scaled.SetNumUninitialized(Count);
+	TArray<int32> Small;
+	TArray<int32> Large;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Scaled[i] = Weights[i] > 0.0f ? Weights[i] * Count / TotalWeight : 0.0;
+		(Scaled[i] < 1.0 ? Small : Large).Add(i);
+	}
+
+	Thresholds.SetNumUninitialized(Count);
+	Aliases.SetNumUninitialized(Count);
+
+	// Vose: fill every small column with a slice of a large one
+	while (Small.Num() > 0 && Large.Num() > 0)
+	{
+		const int32 Less = Small.Pop();
+		const int32 More = Large.Last();
+		Thresholds[Less] = static_cast<uint32>(Scaled[Less] * 4294967296.0);
+		Aliases[Less] = More;
+		Scaled[More] -= 1.0 - Scaled[Less];
+		if (Scaled[More] < 1.0)
+		{
+			Large.Pop();
+			Small.Add(More);
+		}
+	}
+
+	// Leftovers are full columns (up to rounding), they always keep themselves
+	for (const int32 Index : Large)
+	{
+		Thresholds[Index] = MAX_uint32;
+		Aliases[Index] = Index;
+	}
+	for (const int32 Index : Small)
+	{
+		Thresholds[Index] = MAX_uint32;
+		Aliases[Index] = Index;
+	}
+	return true;
+}
+
+int32 RandomAliasTable::Sample(RandomEngine& Engine) const
+{
+	if (!IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomAliasTable::Sample - Table is empty"));
+		return INDEX_NONE;
+	}
+	const uint32 RawIndex = Engine.RandUInt32();
+	const uint32 RawCoin = Engine.RandUInt32();
+	return Sample(RawIndex, RawCoin);
+}
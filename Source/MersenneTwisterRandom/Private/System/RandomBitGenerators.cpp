@@ -0,0 +1,248 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "System/RandomBitGenerators.h"
+
+/* SFMT19937 */
+
+namespace SFMTParams
+{
+	constexpr int32 Pos1 = 122;
+	constexpr int32 ShiftLeft1 = 18;
+	constexpr int32 ShiftLeft2 = 1;
+	constexpr int32 ShiftRight1 = 11;
+	constexpr int32 ShiftRight2 = 1;
+	constexpr uint32 Mask[4] = {0xDFFFFFEFu, 0xDDFECB7Fu, 0xBFFAFFFFu, 0xBFFFFFF6u};
+	constexpr uint32 Parity[4] = {0x00000001u, 0x00000000u, 0x00000000u, 0x13C9E684u};
+
+	/** Shifts a 128-bit word left by Bytes bytes */
+	FORCEINLINE void ShiftLeft128(uint32* Out, const uint32* In, const int32 Bytes)
+	{
+		const uint64 High = (static_cast<uint64>(In[3]) << 32) | In[2];
+		const uint64 Low = (static_cast<uint64>(In[1]) << 32) | In[0];
+		const uint64 OutHigh = (High << (Bytes * 8)) | (Low >> (64 - Bytes * 8));
+		const uint64 OutLow = Low << (Bytes * 8);
+		Out[0] = static_cast<uint32>(OutLow);
+		Out[1] = static_cast<uint32>(OutLow >> 32);
+		Out[2] = static_cast<uint32>(OutHigh);
+		Out[3] = static_cast<uint32>(OutHigh >> 32);
+	}
+
+	/** Shifts a 128-bit word right by Bytes bytes */
+	FORCEINLINE void ShiftRight128(uint32* Out, const uint32* In, const int32 Bytes)
+	{
+		const uint64 High = (static_cast<uint64>(In[3]) << 32) | In[2];
+		const uint64 Low = (static_cast<uint64>(In[1]) << 32) | In[0];
+		const uint64 OutLow = (Low >> (Bytes * 8)) | (High << (64 - Bytes * 8));
+		const uint64 OutHigh = High >> (Bytes * 8);
+		Out[0] = static_cast<uint32>(OutLow);
+		Out[1] = static_cast<uint32>(OutLow >> 32);
+		Out[2] = static_cast<uint32>(OutHigh);
+		Out[3] = static_cast<uint32>(OutHigh >> 32);
+	}
+
+	/** One SFMT recursion step on 128-bit words A (in place), B, C and D */
+	FORCEINLINE void Recursion(uint32* A, const uint32* B, const uint32* C, const uint32* D)
+	{
+		uint32 X[4];
+		uint32 Y[4];
+		ShiftLeft128(X, A, ShiftLeft2);
+		ShiftRight128(Y, C, ShiftRight2);
+		for (int32 k = 0; k < 4; ++k)
+		{
+			A[k] = A[k] ^ X[k] ^ ((B[k] >> ShiftRight1) & Mask[k]) ^ Y[k] ^ (D[k] << ShiftLeft1);
+		}
+	}
+}
+
+SFMT19937::SFMT19937(const uint32 InSeed)
+{
+	// Same initialization as init_gen_rand in the reference implementation
+	State[0] = InSeed;
+	for (int32 i = 1; i < StateSize32; ++i)
+	{
+		State[i] = 1812433253u * (State[i - 1] ^ (State[i - 1] >> 30)) + static_cast<uint32>(i);
+	}
+	Index = StateSize32;
+
+	// Period certification: fix one bit if the state would fall on a shorter cycle
+	uint32 Inner = 0;
+	for (int32 i = 0; i < 4; ++i)
+	{
+		Inner ^= State[i] & SFMTParams::Parity[i];
+	}
+	for (int32 i = 16; i > 0; i >>= 1)
+	{
+		Inner ^= Inner >> i;
+	}
+	if ((Inner & 1) == 1)
+	{
+		return;
+	}
+	for (int32 i = 0; i < 4; ++i)
+	{
+		for (uint32 Work = 1; Work != 0; Work <<= 1)
+		{
+			if ((Work & SFMTParams::Parity[i]) != 0)
+			{
+				State[i] ^= Work;
+				return;
+			}
+		}
+	}
+}
+
+void SFMT19937::GenerateAll()
+{
+	using namespace SFMTParams;
+
+	const uint32* R1 = &State[(StateSize128 - 2) * 4];
+	const uint32* R2 = &State[(StateSize128 - 1) * 4];
+	int32 i = 0;
+	for (; i < StateSize128 - Pos1; ++i)
+	{
+		Recursion(&State[i * 4], &State[(i + Pos1) * 4], R1, R2);
+		R1 = R2;
+		R2 = &State[i * 4];
+	}
+	for (; i < StateSize128; ++i)
+	{
+		Recursion(&State[i * 4], &State[(i + Pos1 - StateSize128) * 4], R1, R2);
+		R1 = R2;
+		R2 = &State[i * 4];
+	}
+	Index = 0;
+}
+
+void SFMT19937::discard(uint64 Count)
+{
+	// Skip whole blocks without tempering, there is no output transform to apply
+	while (Count > 0)
+	{
+		if (Index >= StateSize32)
+		{
+			GenerateAll();
+		}
+		const int32 Step = static_cast<int32>(FMath::Min<uint64>(Count, static_cast<uint64>(StateSize32 - Index)));
+		Index += Step;
+		Count -= Step;
+	}
+}
+
+/* PCG64 */
+
+PCG64::PCG64(const uint64 InSeed): StateHigh(0), StateLow(InSeed)
+{
+	// pcg-cpp seeding: state = (seed + increment) * multiplier + increment
+	Add128(StateHigh, StateLow, IncrementHigh, IncrementLow);
+	Step();
+}
+
+void PCG64::discard(uint64 Count)
+{
+	// Jump ahead by composing the affine step with itself (Brown, "Random number generation with arbitrary strides")
+	uint64 AccMultHigh = 0;
+	uint64 AccMultLow = 1;
+	uint64 AccPlusHigh = 0;
+	uint64 AccPlusLow = 0;
+	uint64 CurMultHigh = MultiplierHigh;
+	uint64 CurMultLow = MultiplierLow;
+	uint64 CurPlusHigh = IncrementHigh;
+	uint64 CurPlusLow = IncrementLow;
+
+	while (Count > 0)
+	{
+		if ((Count & 1) != 0)
+		{
+			Multiply128(AccMultHigh, AccMultLow, CurMultHigh, CurMultLow, AccMultHigh, AccMultLow);
+			Multiply128(AccPlusHigh, AccPlusLow, CurMultHigh, CurMultLow, AccPlusHigh, AccPlusLow);
+			Add128(AccPlusHigh, AccPlusLow, CurPlusHigh, CurPlusLow);
+		}
+		uint64 MultPlusOneHigh = CurMultHigh;
+		uint64 MultPlusOneLow = CurMultLow;
+		Add128(MultPlusOneHigh, MultPlusOneLow, 0, 1);
+		Multiply128(MultPlusOneHigh, MultPlusOneLow, CurPlusHigh, CurPlusLow, CurPlusHigh, CurPlusLow);
+		Multiply128(CurMultHigh, CurMultLow, CurMultHigh, CurMultLow, CurMultHigh, CurMultLow);
+		Count >>= 1;
+	}
+
+	Multiply128(AccMultHigh, AccMultLow, StateHigh, StateLow, StateHigh, StateLow);
+	Add128(StateHigh, StateLow, AccPlusHigh, AccPlusLow);
+}
+
+/* XOSHIRO256++ */
+
+Xoshiro256PlusPlus::Xoshiro256PlusPlus(const uint64 InSeed)
+{
+	// SplitMix64 expansion, never yields the all-zero state
+	uint64 X = InSeed;
+	for (uint64& Word : S)
+	{
+		uint64 Z = (X += 0x9E3779B97F4A7C15ull);
+		Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+		Word = Z ^ (Z >> 31);
+	}
+}
+
+void Xoshiro256PlusPlus::discard(uint64 Count)
+{
+	while (Count-- > 0)
+	{
+		(*this)();
+	}
+}
+
+/* RANDOM BIT GENERATOR */
+
+namespace RandomBitGeneratorPrivate
+{
+	using FState = TVariant<std::mt19937, SFMT19937, PCG64, Xoshiro256PlusPlus>;
+
+	FState MakeState(const ERandomEngineBackend Backend, const uint32 Seed)
+	{
+		switch (Backend)
+		{
+		case ERandomEngineBackend::SFMT:
+			return FState(TInPlaceType<SFMT19937>(), Seed);
+		case ERandomEngineBackend::PCG64:
+			return FState(TInPlaceType<PCG64>(), static_cast<uint64>(Seed));
+		case ERandomEngineBackend::Xoshiro256PlusPlus:
+			return FState(TInPlaceType<Xoshiro256PlusPlus>(), static_cast<uint64>(Seed));
+		default:
+			return FState(TInPlaceType<std::mt19937>(), Seed);
+		}
+	}
+}
+
+RandomBitGenerator::RandomBitGenerator(const ERandomEngineBackend InBackend, const uint32 InSeed):
+	Backend(InBackend), State(RandomBitGeneratorPrivate::MakeState(InBackend, InSeed))
+{
+}
+
+void RandomBitGenerator::discard(const uint64 Count)
+{
+	Visit([Count](auto& Generator)
+	{
+		Generator.discard(Count);
+	});
+}
+
+void RandomBitGenerator::Fill(TArrayView<uint32> OutValues)
+{
+	Visit([OutValues](auto& Generator)
+	{
+		using FGenerator = std::decay_t<decltype(Generator)>;
+		for (uint32& Value : OutValues)
+		{
+			if constexpr (FGenerator::max() > MAX_uint32)
+			{
+				Value = static_cast<uint32>(Generator() >> 32);
+			}
+			else
+			{
+				Value = static_cast<uint32>(Generator());
+			}
+		}
+	});
+}
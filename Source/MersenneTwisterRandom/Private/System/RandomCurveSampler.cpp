@@ -0,0 +1,352 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "System/RandomCurveSampler.h"
+#include "System/RandomKernels.h"
+#include "Curves/CurveFloat.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/PackageReload.h"
+
+namespace RandomCurveSamplerPrivate
+{
+	using FSamplerPtr = TSharedPtr<const RandomCurveSampler, ESPMode::ThreadSafe>;
+
+	/** Shared samplers of curve assets */
+	struct FSamplerCache
+	{
+		FRWLock Lock;
+		TMap<FObjectKey, FSamplerPtr> Samplers;
+
+		/** Bumped by every invalidation, a bake that saw an older value may have read a changing curve */
+		uint64 Generation = 0;
+
+		FDelegateHandle PostGarbageCollectHandle;
+		FDelegateHandle PackageReloadedHandle;
+		FDelegateHandle ReloadCompleteHandle;
+#if WITH_EDITOR
+		FDelegateHandle ObjectModifiedHandle;
+		FDelegateHandle PropertyChangedHandle;
+#endif
+	};
+
+	FSamplerCache& GetCache()
+	{
+		static FSamplerCache Cache;
+		return Cache;
+	}
+
+	void InvalidateObject(UObject* Object)
+	{
+		if (const UCurveFloat* Curve = Cast<UCurveFloat>(Object))
+		{
+			RandomCurveSampler::Invalidate(*Curve);
+		}
+	}
+
+	void OnPostGarbageCollect()
+	{
+		// Keys hold a serial number, a new curve at the address of a collected one never matches
+		FSamplerCache& Cache = GetCache();
+		FWriteScopeLock WriteLock(Cache.Lock);
+		for (auto It = Cache.Samplers.CreateIterator(); It; ++It)
+		{
+			if (It.Key().ResolveObjectPtr() == nullptr)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	void OnPackageReloaded(const EPackageReloadPhase Phase, FPackageReloadedEvent* Event)
+	{
+		if (Phase == EPackageReloadPhase::PostPackageFixup)
+		{
+			RandomCurveSampler::InvalidateAll();
+		}
+	}
+
+	void OnReloadComplete(const EReloadCompleteReason Reason)
+	{
+		RandomCurveSampler::InvalidateAll();
+	}
+
+#if WITH_EDITOR
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+	{
+		InvalidateObject(Object);
+	}
+#endif
+
+	/**
+	 * Finds the offset in a segment of linear density where the area reaches a target
+	 * @param Start - Density at the start of the segment
+	 * @param End - Density at the end of the segment
+	 * @param Area - Target area from the start, divided by the segment width
+	 * @return Offset as a fraction of the segment, in [0, 1]
+	 */
+	float SolveSegment(const double Start, const double End, const double Area)
+	{
+		// Root of (End - Start) / 2 * s^2 + Start * s = Area, written without cancellation
+		const double Root = FMath::Sqrt(FMath::Max(Start * Start + 2.0 * (End - Start) * Area, 0.0));
+		const double Denominator = Start + Root;
+		return Denominator > 0.0 ? FMath::Clamp(static_cast<float>(2.0 * Area / Denominator), 0.0f, 1.0f) : 0.0f;
+	}
+}
+
+float RandomCurveSampler::Lerp(const TArray<float>& Table, const float Position)
+{
+	const int32 Index = FMath::Min(static_cast<int32>(Position), Table.Num() - 2);
+	const float Alpha = Position - Index;
+	return Table[Index] + (Table[Index + 1] - Table[Index]) * Alpha;
+}
+
+bool RandomCurveSampler::Build(const FRichCurve& Curve, const int32 Resolution)
+{
+	using namespace RandomCurveSamplerPrivate;
+
+	Values.Reset();
+	InverseCdf.Reset();
+	MinTime = 0.0f;
+	MaxTime = 0.0f;
+	TimeToPosition = 0.0f;
+
+	if (Curve.IsEmpty())
+	{
+		return false;
+	}
+
+	MinTime = Curve.GetFirstKey().Time;
+	MaxTime = Curve.GetLastKey().Time;
+	const float Span = MaxTime - MinTime;
+
+	// A single key (or keys at one time) is a constant, all the density sits at that time
+	if (Span <= 0.0f)
+	{
+		const float Value = Curve.Eval(MinTime);
+		Values.Init(Value, 2);
+		if (Value > 0.0f)
+		{
+			InverseCdf.Init(MinTime, 2);
+		}
+		return true;
+	}
+
+	const int32 Count = FMath::Max(Resolution, 2);
+	const float Step = Span / (Count - 1);
+	TimeToPosition = (Count - 1) / Span;
+
+	Values.SetNumUninitialized(Count);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Values[i] = Curve.Eval(i == Count - 1 ? MaxTime : MinTime + i * Step);
+	}
+
+	// Trapezoid areas of the clamped curve, the density is linear between table entries
+	TArray<double> Cumulative;
+	Cumulative.SetNumUninitialized(Count);
+	Cumulative[0] = 0.0;
+	for (int32 i = 1; i < Count; ++i)
+	{
+		Cumulative[i] = Cumulative[i - 1] + 0.5 * (FMath::Max(Values[i - 1], 0.0f) + FMath::Max(Values[i], 0.0f)) * Step;
+	}
+	const double TotalArea = Cumulative[Count - 1];
+	if (TotalArea <= 0.0)
+	{
+		return true;
+	}
+
+	// Invert the CDF at evenly spaced levels, solving each segment exactly
+	InverseCdf.SetNumUninitialized(Count);
+	int32 Segment = 0;
+	for (int32 Level = 0; Level < Count - 1; ++Level)
+	{
+		const double Target = TotalArea * Level / (Count - 1);
+		while (Segment < Count - 2 && Cumulative[Segment + 1] <= Target)
+		{
+			++Segment;
+		}
+		const double Start = FMath::Max(Values[Segment], 0.0f);
+		const double End = FMath::Max(Values[Segment + 1], 0.0f);
+		const float Offset = SolveSegment(Start, End, (Target - Cumulative[Segment]) / Step);
+		InverseCdf[Level] = MinTime + (Segment + Offset) * Step;
+	}
+
+	// The last level is where the area stops growing, not MaxTime, so a trailing zero stretch is never sampled
+	int32 Last = Count - 1;
+	while (Last > 0 && Cumulative[Last - 1] >= TotalArea)
+	{
+		--Last;
+	}
+	InverseCdf[Count - 1] = Last == Count - 1 ? MaxTime : MinTime + Last * Step;
+	return true;
+}
+
+float RandomCurveSampler::Eval(const float Time) const
+{
+	if (!IsValid())
+	{
+		return 0.0f;
+	}
+	const float Position = FMath::Clamp((Time - MinTime) * TimeToPosition, 0.0f, static_cast<float>(Values.Num() - 1));
+	return Lerp(Values, Position);
+}
+
+float RandomCurveSampler::RandValue(RandomEngine& Engine) const
+{
+	if (!IsValid())
+	{
+		return 0.0f;
+	}
+	const float Unit = RandomKernels::UnitFloat(Engine.RandUInt32());
+	return Lerp(Values, Unit * (Values.Num() - 1));
+}
+
+float RandomCurveSampler::RandTime(RandomEngine& Engine) const
+{
+	if (!HasDensity())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomCurveSampler::RandTime - Curve has no positive area"));
+		return MinTime;
+	}
+	const float Unit = RandomKernels::UnitFloat(Engine.RandUInt32());
+	return Lerp(InverseCdf, Unit * (InverseCdf.Num() - 1));
+}
+
+void RandomCurveSampler::RandValues(RandomEngine& Engine, TArrayView<float> OutValues) const
+{
+	using namespace RandomKernels;
+
+	if (!IsValid())
+	{
+		for (float& Value : OutValues)
+		{
+			Value = 0.0f;
+		}
+		return;
+	}
+
+	const float Scale = Values.Num() - 1;
+	uint32 Raw[ChunkSize];
+	for (int32 Start = 0; Start < OutValues.Num(); Start += ChunkSize)
+	{
+		const int32 ChunkCount = FMath::Min(ChunkSize, OutValues.Num() - Start);
+		Engine.RandUInt32s(TArrayView<uint32>(Raw, ChunkCount));
+		for (int32 i = 0; i < ChunkCount; ++i)
+		{
+			OutValues[Start + i] = Lerp(Values, UnitFloat(Raw[i]) * Scale);
+		}
+	}
+}
+
+void RandomCurveSampler::RandTimes(RandomEngine& Engine, TArrayView<float> OutTimes) const
+{
+	using namespace RandomKernels;
+
+	if (!HasDensity())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomCurveSampler::RandTimes - Curve has no positive area"));
+		for (float& Time : OutTimes)
+		{
+			Time = MinTime;
+		}
+		return;
+	}
+
+	const float Scale = InverseCdf.Num() - 1;
+	uint32 Raw[ChunkSize];
+	for (int32 Start = 0; Start < OutTimes.Num(); Start += ChunkSize)
+	{
+		const int32 ChunkCount = FMath::Min(ChunkSize, OutTimes.Num() - Start);
+		Engine.RandUInt32s(TArrayView<uint32>(Raw, ChunkCount));
+		for (int32 i = 0; i < ChunkCount; ++i)
+		{
+			OutTimes[Start + i] = Lerp(InverseCdf, UnitFloat(Raw[i]) * Scale);
+		}
+	}
+}
+
+TSharedRef<const RandomCurveSampler, ESPMode::ThreadSafe> RandomCurveSampler::FindOrBuild(const UCurveFloat& Curve)
+{
+	using namespace RandomCurveSamplerPrivate;
+
+	FSamplerCache& Cache = GetCache();
+	const FObjectKey Key(&Curve);
+	uint64 Generation;
+	{
+		FReadScopeLock ReadLock(Cache.Lock);
+		if (const FSamplerPtr* Found = Cache.Samplers.Find(Key))
+		{
+			return Found->ToSharedRef();
+		}
+		Generation = Cache.Generation;
+	}
+
+	// Bake outside the lock, if another thread got there first its sampler is kept
+	const TSharedRef<RandomCurveSampler, ESPMode::ThreadSafe> Sampler = MakeShared<RandomCurveSampler, ESPMode::ThreadSafe>();
+	Sampler->Build(Curve.FloatCurve);
+
+	FWriteScopeLock WriteLock(Cache.Lock);
+	if (const FSamplerPtr* Found = Cache.Samplers.Find(Key))
+	{
+		return Found->ToSharedRef();
+	}
+
+	// An invalidation during the bake means the curve changed under it: serve this sampler once
+	// but do not cache it, the next call bakes the new keys
+	if (Cache.Generation == Generation)
+	{
+		Cache.Samplers.Add(Key, Sampler);
+	}
+	return Sampler;
+}
+
+void RandomCurveSampler::Invalidate(const UCurveFloat& Curve)
+{
+	using namespace RandomCurveSamplerPrivate;
+
+	FSamplerCache& Cache = GetCache();
+	FWriteScopeLock WriteLock(Cache.Lock);
+	Cache.Samplers.Remove(FObjectKey(&Curve));
+	++Cache.Generation;
+}
+
+void RandomCurveSampler::InvalidateAll()
+{
+	using namespace RandomCurveSamplerPrivate;
+
+	FSamplerCache& Cache = GetCache();
+	FWriteScopeLock WriteLock(Cache.Lock);
+	Cache.Samplers.Reset();
+	++Cache.Generation;
+}
+
+void RandomCurveSampler::RegisterCacheEvents()
+{
+	using namespace RandomCurveSamplerPrivate;
+
+	FSamplerCache& Cache = GetCache();
+	Cache.PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddStatic(&OnPostGarbageCollect);
+	Cache.PackageReloadedHandle = FCoreUObjectDelegates::OnPackageReloaded.AddStatic(&OnPackageReloaded);
+	Cache.ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddStatic(&OnReloadComplete);
+#if WITH_EDITOR
+	// Curve editors call Modify before changing keys and undo ends in PostEditChange
+	Cache.ObjectModifiedHandle = FCoreUObjectDelegates::OnObjectModified.AddStatic(&InvalidateObject);
+	Cache.PropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddStatic(&OnObjectPropertyChanged);
+#endif
+}
+
+void RandomCurveSampler::UnregisterCacheEvents()
+{
+	using namespace RandomCurveSamplerPrivate;
+
+	FSamplerCache& Cache = GetCache();
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(Cache.PostGarbageCollectHandle);
+	FCoreUObjectDelegates::OnPackageReloaded.Remove(Cache.PackageReloadedHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(Cache.ReloadCompleteHandle);
+#if WITH_EDITOR
+	FCoreUObjectDelegates::OnObjectModified.Remove(Cache.ObjectModifiedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(Cache.PropertyChangedHandle);
+#endif
+	InvalidateAll();
+}
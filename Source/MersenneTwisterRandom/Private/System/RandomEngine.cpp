@@ -1,6 +1,7 @@
 ﻿// Fill out your copyright notice in the Description page of Project Settings.
 
 #include "System/RandomEngine.h"
+#include "System/RandomKernels.h"
 
 RandomEngine::RandomEngine(): RandomEngine(StaticNewSeed())
 {
@@ -9,9 +10,10 @@ RandomEngine::RandomEngine(): RandomEngine(StaticNewSeed())
 /**
  * Constructor - Initializes the random engine with a specific seed
  * @param InSeed - The seed value for reproducible random generation
+ * @param InBackend - Bit generator backend, Mersenne Twister keeps the historical sequences
  */
-RandomEngine::RandomEngine(int32 InSeed):
-	Seed(InSeed), Generator(InSeed), GeneratedCount(0)
+RandomEngine::RandomEngine(int32 InSeed, ERandomEngineBackend InBackend):
+	Seed(InSeed), Generator(InBackend, InSeed), GeneratedCount(0)
 {
 }
 
@@ -27,6 +29,11 @@ int32 RandomEngine::GetRootSeed() const
 	return Seed;
 }
 
+ERandomEngineBackend RandomEngine::GetBackend() const
+{
+	return Generator.GetBackend();
+}
+
 /**
  * Generates a random integer within the specified range (inclusive)
  * @param Min - Minimum value (inclusive), defaults to 0
@@ -40,6 +47,26 @@ int32 RandomEngine::RandInt(const int32 Min, const int32 Max)
 	return Distribution(Generator);
 }
 
+/**
+ * Generates a raw 32-bit value straight from the generator
+ * @return Uniform value over the full uint32 range
+ */
+uint32 RandomEngine::RandUInt32()
+{
+	GeneratedCount++;
+	return static_cast<uint32>(Generator());
+}
+
+/**
+ * Fills an array with raw 32-bit values, the backend is dispatched once for the whole array
+ * @param OutValues - Array to fill, every element is overwritten
+ */
+void RandomEngine::RandUInt32s(TArrayView<uint32> OutValues)
+{
+	Generator.Fill(OutValues);
+	GeneratedCount += OutValues.Num();
+}
+
 /**
  * Generates a random float within the specified range (inclusive)
  * @param Min - Minimum value (inclusive), defaults to 0.0f
@@ -53,6 +80,27 @@ float RandomEngine::RandFloat(const float Min, const float Max)
 	return Distribution(Generator);
 }
 
+/**
+ * Fills an array with uniform floats from bulk raw draws (one raw draw per value)
+ * @param OutValues - Array to fill, every element is overwritten
+ * @param Min - Minimum value (inclusive), defaults to 0.0f
+ * @param Max - Maximum value (exclusive), defaults to 1.0f
+ */
+void RandomEngine::RandFloats(TArrayView<float> OutValues, const float Min, const float Max)
+{
+	uint32 Raw[RandomKernels::ChunkSize];
+	const float Range = Max - Min;
+	for (int32 Start = 0; Start < OutValues.Num(); Start += RandomKernels::ChunkSize)
+	{
+		const int32 Count = FMath::Min(RandomKernels::ChunkSize, OutValues.Num() - Start);
+		RandUInt32s(TArrayView<uint32>(Raw, Count));
+		for (int32 i = 0; i < Count; ++i)
+		{
+			OutValues[Start + i] = Min + Range * RandomKernels::UnitFloat(Raw[i]);
+		}
+	}
+}
+
 /**
  * Generates a random float with bias toward a specific value
  * Uses multiple samples and selects the one closest to bias point
@@ -169,6 +217,34 @@ int32 RandomEngine::StaticNewSeed()
 	return Rd();
 }
 
+/**
+ * Derives a child seed from a root seed and a key
+ * @param RootSeed - The seed of the parent generator
+ * @param Key - Identifier of the child stream
+ * @return A well-mixed seed for the child generator
+ */
+int32 RandomEngine::StaticDeriveSeed(const int32 RootSeed, const uint32 Key)
+{
+	// SplitMix64 finalizer: neighbouring keys give unrelated seeds, so mt19937 streams do not correlate
+	uint64 Z = ((static_cast<uint64>(static_cast<uint32>(RootSeed)) << 32) | Key) + 0x9E3779B97F4A7C15ull;
+	Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBull;
+	Z = Z ^ (Z >> 31);
+	return static_cast<int32>(static_cast<uint32>(Z ^ (Z >> 32)));
+}
+
+/**
+ * Derives a child seed from a root seed and a name (case-insensitive)
+ * @param RootSeed - The seed of the parent generator
+ * @param Name - Name of the child stream
+ * @return A well-mixed seed for the child generator
+ */
+int32 RandomEngine::StaticDeriveSeed(const int32 RootSeed, const FName Name)
+{
+	// FName hashes depend on name table order, so hash the text to stay stable across runs
+	return StaticDeriveSeed(RootSeed, FCrc::StrCrc32(*Name.ToString().ToLower()));
+}
+
 /**
  * Generates a random integer using Unreal's built-in random generator (lower quality)
  * @param Min - Minimum value (inclusive)
@@ -422,7 +498,7 @@ float RandomEngine::RandCurveRange(const FRichCurve& Curve, const float Min, con
  */
 void RandomEngine::Discard(const uint32 Count)
 {
-	// Use the discard method of the underlying Mersenne Twister generator
+	// Use the discard method of the underlying generator
 	Generator.discard(Count);
 	GeneratedCount += Count;
 }
@@ -467,7 +543,7 @@ uint32 RandomEngine::GetCurrentState() const
 void RandomEngine::Reset()
 {
 	// Reinitialize the generator with the original seed
-	Generator = std::mt19937(Seed);
+	Generator = RandomBitGenerator(Generator.GetBackend(), Seed);
 	GeneratedCount = 0;
 }
 
@@ -0,0 +1,334 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "System/RandomEngine.h"
+
+/**
+ * Branch-free math kernels shared by the batch generators
+ *
+ * Everything here is plain arithmetic and selects, so loops calling these functions over
+ * arrays compile to vector instructions. They trade the last ulp of accuracy for that:
+ * results are within a few 1e-7 of the FMath equivalents.
+ */
+namespace RandomKernels
+{
+	/** Number of values the batch generators process per chunk, sized to stay in L1 */
+	constexpr int32 ChunkSize = 256;
+
+	/**
+	 * Maps a raw 32-bit value to [0, 1) using its 24 high bits, the float mantissa precision
+	 * @param Raw - Raw 32-bit value
+	 * @return Uniform float in [0, 1)
+	 */
+	FORCEINLINE float UnitFloat(const uint32 Raw)
+	{
+		return static_cast<float>(Raw >> 8) * (1.0f / 16777216.0f);
+	}
+
+	/**
+	 * Maps a raw 32-bit value to (0, 1], for logarithms and roots that must not see zero
+	 * @param Raw - Raw 32-bit value
+	 * @return Uniform float in (0, 1]
+	 */
+	FORCEINLINE float UnitFloatOpenZero(const uint32 Raw)
+	{
+		return static_cast<float>((Raw >> 8) + 1) * (1.0f / 16777216.0f);
+	}
+
+	/**
+	 * Draws a uniform index in [0, Range) from raw draws with a multiply-shift (Lemire)
+	 * Unlike std::uniform_int_distribution, the result is the same with every standard library
+	 * @param Engine - Engine the raw values are drawn from
+	 * @param Range - Number of possible indices, at least 1
+	 * @return Uniform index below Range
+	 */
+	FORCEINLINE uint32 BoundedIndex(RandomEngine& Engine, const uint32 Range)
+	{
+		uint64 Product = static_cast<uint64>(Engine.RandUInt32()) * Range;
+		if (static_cast<uint32>(Product) < Range)
+		{
+			const uint32 Threshold = (0u - Range) % Range;
+			while (static_cast<uint32>(Product) < Threshold)
+			{
+				Product = static_cast<uint64>(Engine.RandUInt32()) * Range;
+			}
+		}
+		return static_cast<uint32>(Product >> 32);
+	}
+
+	/**
+	 * Computes sin and cos of a full-turn fraction (angle = 2 * PI * Turns)
+	 * @param Turns - Angle in turns, in [0, 1)
+	 * @param OutSin - sin(2 * PI * Turns)
+	 * @param OutCos - cos(2 * PI * Turns)
+	 */
+	FORCEINLINE void SinCosTurns(const float Turns, float& OutSin, float& OutCos)
+	{
+		// Shift to [-0.5, 0.5): sin and cos both flip sign
+		const float Centered = Turns - 0.5f;
+
+		// Fold into [-0.25, 0.25]: sin is unchanged, cos flips sign again
+		const float Half = Centered < 0.0f ? -0.5f : 0.5f;
+		const bool bFold = FMath::Abs(Centered) > 0.25f;
+		const float Folded = bFold ? Half - Centered : Centered;
+		const float CosSign = bFold ? 1.0f : -1.0f;
+
+		// Taylor polynomials on [-PI/2, PI/2]
+		const float X = Folded * (2.0f * PI);
+		const float X2 = X * X;
+		const float Sin = X * (1.0f + X2 * (-1.0f / 6.0f + X2 * (1.0f / 120.0f + X2 * (-1.0f / 5040.0f + X2 * (1.0f / 362880.0f + X2 * (-1.0f / 39916800.0f))))));
+		const float Cos = 1.0f + X2 * (-0.5f + X2 * (1.0f / 24.0f + X2 * (-1.0f / 720.0f + X2 * (1.0f / 40320.0f + X2 * (-1.0f / 3628800.0f + X2 * (1.0f / 479001600.0f))))));
+
+		OutSin = -Sin;
+		OutCos = CosSign * Cos;
+	}
+
+	/**
+	 * Computes the cube root of a value in [0, 1]
+	 * @param Value - Value in [0, 1]
+	 * @return Cube root of Value
+	 */
+	FORCEINLINE float CubeRoot01(const float Value)
+	{
+		// Exponent divided by three as an initial guess, then Newton steps
+		uint32 Bits;
+		FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+		Bits = Bits / 3 + 709921077u;
+		float Root;
+		FMemory::Memcpy(&Root, &Bits, sizeof(Root));
+		for (int32 i = 0; i < 3; ++i)
+		{
+			Root = (2.0f * Root + Value / (Root * Root)) * (1.0f / 3.0f);
+		}
+		return Value > 0.0f ? Root : 0.0f;
+	}
+
+	/**
+	 * Maps the unit square to the unit disk, area-preserving (Shirley & Chiu concentric mapping)
+	 * Neighbouring square points stay neighbours, so stratified and low-discrepancy inputs keep their spread.
+	 * @param U - First coordinate, in [0, 1)
+	 * @param V - Second coordinate, in [0, 1)
+	 * @param OutX - X in the unit disk
+	 * @param OutY - Y in the unit disk
+	 */
+	FORCEINLINE void SquareToDisk(const float U, const float V, float& OutX, float& OutY)
+	{
+		const float A = 2.0f * U - 1.0f;
+		const float B = 2.0f * V - 1.0f;
+		if (A == 0.0f && B == 0.0f)
+		{
+			OutX = 0.0f;
+			OutY = 0.0f;
+			return;
+		}
+
+		// Angle in turns: B / A * 1/8 in the left/right wedges, 1/4 - A / B * 1/8 in the top/bottom ones
+		const bool bHorizontal = FMath::Abs(A) > FMath::Abs(B);
+		const float Radius = bHorizontal ? A : B;
+		const float Turns = bHorizontal ? B / (8.0f * A) : 0.25f - A / (8.0f * B);
+		float Sin;
+		float Cos;
+		SinCosTurns(Turns < 0.0f ? Turns + 1.0f : Turns, Sin, Cos);
+		OutX = Radius * Cos;
+		OutY = Radius * Sin;
+	}
+
+	/**
+	 * Maps the unit square to the unit sphere surface, area-preserving (uniform cos(polar) and azimuth)
+	 * @param U - Mapped to the height, in [0, 1)
+	 * @param V - Mapped to the azimuth, in [0, 1)
+	 * @param OutX - X on the unit sphere
+	 * @param OutY - Y on the unit sphere
+	 * @param OutZ - Z on the unit sphere
+	 */
+	FORCEINLINE void SquareToSphere(const float U, const float V, float& OutX, float& OutY, float& OutZ)
+	{
+		const float CosPolar = 2.0f * U - 1.0f;
+		const float SinPolar = FMath::Sqrt(FMath::Max(0.0f, 1.0f - CosPolar * CosPolar));
+		float SinAzimuth;
+		float CosAzimuth;
+		SinCosTurns(V, SinAzimuth, CosAzimuth);
+		OutX = SinPolar * CosAzimuth;
+		OutY = SinPolar * SinAzimuth;
+		OutZ = CosPolar;
+	}
+
+	/**
+	 * Maps the unit cube to the unit ball, volume-preserving (sphere direction, cube root radius)
+	 * @param U - Mapped to the height, in [0, 1)
+	 * @param V - Mapped to the azimuth, in [0, 1)
+	 * @param W - Mapped to the radius, in [0, 1)
+	 * @param OutX - X in the unit ball
+	 * @param OutY - Y in the unit ball
+	 * @param OutZ - Z in the unit ball
+	 */
+	FORCEINLINE void CubeToBall(const float U, const float V, const float W, float& OutX, float& OutY, float& OutZ)
+	{
+		SquareToSphere(U, V, OutX, OutY, OutZ);
+		const float Radius = CubeRoot01(W);
+		OutX *= Radius;
+		OutY *= Radius;
+		OutZ *= Radius;
+	}
+
+	/**
+	 * Builds a unit direction around +Z from the cosine of its polar angle and an azimuth
+	 * @param CosPolar - Cosine of the angle to +Z, in [-1, 1]
+	 * @param Turns - Azimuth in turns, in [0, 1)
+	 * @param OutX - X of the direction
+	 * @param OutY - Y of the direction
+	 * @param OutZ - Z of the direction (CosPolar)
+	 */
+	FORCEINLINE void PolarToDirection(const float CosPolar, const float Turns, float& OutX, float& OutY, float& OutZ)
+	{
+		const float SinPolar = FMath::Sqrt(FMath::Max(0.0f, 1.0f - CosPolar * CosPolar));
+		float SinAzimuth;
+		float CosAzimuth;
+		SinCosTurns(Turns, SinAzimuth, CosAzimuth);
+		OutX = SinPolar * CosAzimuth;
+		OutY = SinPolar * SinAzimuth;
+		OutZ = CosPolar;
+	}
+
+	/**
+	 * Maps the unit square to the +Z hemisphere, uniform over solid angle (pdf 1 / (2 PI))
+	 * @param U - Mapped to the height, in [0, 1)
+	 * @param V - Mapped to the azimuth, in [0, 1)
+	 */
+	FORCEINLINE void SquareToHemisphere(const float U, const float V, float& OutX, float& OutY, float& OutZ)
+	{
+		PolarToDirection(1.0f - U, V, OutX, OutY, OutZ);
+	}
+
+	/**
+	 * Maps the unit square to the +Z hemisphere with cosine density (pdf cos / PI)
+	 * Concentric disk lifted onto the hemisphere (Malley's method), so stratification carries over.
+	 * @param U - First coordinate, in [0, 1)
+	 * @param V - Second coordinate, in [0, 1)
+	 */
+	FORCEINLINE void SquareToCosineHemisphere(const float U, const float V, float& OutX, float& OutY, float& OutZ)
+	{
+		SquareToDisk(U, V, OutX, OutY);
+		OutZ = FMath::Sqrt(FMath::Max(0.0f, 1.0f - OutX * OutX - OutY * OutY));
+	}
+
+	/**
+	 * Maps the unit square to the +Z hemisphere with density cos^Exponent (Phong lobe, pdf (n + 1) / (2 PI) cos^n)
+	 * @param U - Mapped to the height, in [0, 1)
+	 * @param V - Mapped to the azimuth, in [0, 1)
+	 * @param InvExponentPlusOne - 1 / (Exponent + 1)
+	 */
+	FORCEINLINE void SquareToPowerCosineHemisphere(const float U, const float V, const float InvExponentPlusOne, float& OutX, float& OutY, float& OutZ)
+	{
+		PolarToDirection(FMath::Pow(1.0f - U, InvExponentPlusOne), V, OutX, OutY, OutZ);
+	}
+
+	/**
+	 * Maps the unit square to GGX (Trowbridge-Reitz) microfacet normals around +Z, density D(h) * cos(h)
+	 * @param U - Mapped to the height, in [0, 1)
+	 * @param V - Mapped to the azimuth, in [0, 1)
+	 * @param AlphaSq - Squared GGX width (roughness^4 with the usual roughness remapping)
+	 */
+	FORCEINLINE void SquareToGGXNormal(const float U, const float V, const float AlphaSq, float& OutX, float& OutY, float& OutZ)
+	{
+		// Inverse CDF of the GGX polar angle: cos^2 = (1 - U) / (1 + (Alpha^2 - 1) * U)
+		const float CosPolarSq = (1.0f - U) / (1.0f + (AlphaSq - 1.0f) * U);
+		PolarToDirection(FMath::Sqrt(CosPolarSq), V, OutX, OutY, OutZ);
+	}
+
+	/**
+	 * Fills an array with standard normal values from bulk raw draws
+	 * Box-Muller: every pair of draws gives two independent values, a radius from the
+	 * logarithm of the first and an angle from the second.
+	 * @param Engine - Engine providing the draws
+	 * @param OutValues - Receives the values
+	 * @param Count - Number of values
+	 */
+	inline void FillGaussians(RandomEngine& Engine, float* OutValues, const int32 Count)
+	{
+		uint32 Raw[ChunkSize];
+		float Values[ChunkSize];
+		for (int32 Start = 0; Start < Count; Start += ChunkSize)
+		{
+			const int32 ChunkCount = FMath::Min(ChunkSize, Count - Start);
+			const int32 Pairs = (ChunkCount + 1) / 2;
+			Engine.RandUInt32s(TArrayView<uint32>(Raw, Pairs * 2));
+			for (int32 i = 0; i < Pairs; ++i)
+			{
+				const float Radius = FMath::Sqrt(-2.0f * FMath::Loge(UnitFloatOpenZero(Raw[i])));
+				float Sin;
+				float Cos;
+				SinCosTurns(UnitFloat(Raw[Pairs + i]), Sin, Cos);
+				Values[2 * i] = Radius * Cos;
+				Values[2 * i + 1] = Radius * Sin;
+			}
+			FMemory::Memcpy(OutValues + Start, Values, ChunkCount * sizeof(float));
+		}
+	}
+
+	/** Number of elements per block in deterministic parallel loops */
+	constexpr int32 ParallelBlockSize = 4096;
+
+	/**
+	 * Runs Body over fixed-size blocks in parallel, each block with its own engine
+	 * Block engines are seeded from one draw of Engine and the block index, so the result
+	 * only depends on the seed, never on the number of worker threads.
+	 * @param Engine - Engine the block seeds are derived from (advanced by one draw)
+	 * @param Num - Number of elements
+	 * @param BlockSize - Number of elements per block
+	 * @param Body - Called as Body(RandomEngine& BlockEngine, int32 Start, int32 Count)
+	 */
+	template <typename FBody>
+	void ParallelForDeterministic(RandomEngine& Engine, const int32 Num, const int32 BlockSize, FBody&& Body)
+	{
+		if (Num <= 0)
+		{
+			return;
+		}
+		const int32 BaseSeed = static_cast<int32>(Engine.RandUInt32());
+		const ERandomEngineBackend Backend = Engine.GetBackend();
+		const int32 BlockCount = FMath::DivideAndRoundUp(Num, BlockSize);
+		ParallelFor(BlockCount, [&](const int32 BlockIndex)
+		{
+			RandomEngine BlockEngine(RandomEngine::StaticDeriveSeed(BaseSeed, static_cast<uint32>(BlockIndex)), Backend);
+			const int32 Start = BlockIndex * BlockSize;
+			Body(BlockEngine, Start, FMath::Min(BlockSize, Num - Start));
+		});
+	}
+
+	/**
+	 * Buffered uniform source for batch samplers that consume a variable number of values
+	 * (rejection loops), refilled from bulk raw draws one chunk at a time
+	 */
+	class FUniformStream
+	{
+		RandomEngine& Engine;
+		uint32 Raw[ChunkSize];
+		int32 Cursor = ChunkSize;
+
+	public:
+		explicit FUniformStream(RandomEngine& InEngine): Engine(InEngine)
+		{
+		}
+
+		/** Next uniform float in [0, 1) */
+		FORCEINLINE float Next()
+		{
+			if (Cursor == ChunkSize)
+			{
+				Engine.RandUInt32s(TArrayView<uint32>(Raw, ChunkSize));
+				Cursor = 0;
+			}
+			return UnitFloat(Raw[Cursor++]);
+		}
+
+		/** Next uniform float in [-1, 1) */
+		FORCEINLINE float NextSigned()
+		{
+			return 2.0f * Next() - 1.0f;
+		}
+	};
+}
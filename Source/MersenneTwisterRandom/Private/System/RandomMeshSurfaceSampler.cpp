@@ -0,0 +1,239 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "System/RandomMeshSurfaceSampler.h"
+#include "System/RandomKernels.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+
+namespace RandomMeshSurfaceSamplerPrivate
+{
+	/** Reads a channel of a color as a weight in [0, 1] */
+	FORCEINLINE float ChannelWeight(const FColor& Color, const ERandomMeshWeightChannel Channel)
+	{
+		switch (Channel)
+		{
+		case ERandomMeshWeightChannel::Red:
+			return Color.R / 255.0f;
+		case ERandomMeshWeightChannel::Green:
+			return Color.G / 255.0f;
+		case ERandomMeshWeightChannel::Blue:
+			return Color.B / 255.0f;
+		case ERandomMeshWeightChannel::Alpha:
+			return Color.A / 255.0f;
+		default:
+			return 1.0f;
+		}
+	}
+}
+
+bool RandomMeshSurfaceSampler::Build(TArrayView<const FVector3f> Positions, TArrayView<const uint32> Indices, TArrayView<const FColor> VertexColors, const ERandomMeshWeightChannel WeightChannel)
+{
+	using namespace RandomMeshSurfaceSamplerPrivate;
+
+	Clear();
+
+	ERandomMeshWeightChannel Channel = WeightChannel;
+	if (Channel != ERandomMeshWeightChannel::None && VertexColors.Num() != Positions.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomMeshSurfaceSampler::Build - Vertex colors do not match the positions, color weighting is ignored"));
+		Channel = ERandomMeshWeightChannel::None;
+	}
+
+	const int32 TriangleCount = Indices.Num() / 3;
+	Origins.Reserve(TriangleCount);
+	EdgesA.Reserve(TriangleCount);
+	EdgesB.Reserve(TriangleCount);
+	Normals.Reserve(TriangleCount);
+	TArray<float> Weights;
+	Weights.Reserve(TriangleCount);
+
+	for (int32 Triangle = 0; Triangle < TriangleCount; ++Triangle)
+	{
+		const uint32 I0 = Indices[Triangle * 3];
+		const uint32 I1 = Indices[Triangle * 3 + 1];
+		const uint32 I2 = Indices[Triangle * 3 + 2];
+		if (I0 >= static_cast<uint32>(Positions.Num()) || I1 >= static_cast<uint32>(Positions.Num()) || I2 >= static_cast<uint32>(Positions.Num()))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("RandomMeshSurfaceSampler::Build - Triangle %d has an out of range index"), Triangle);
+			Clear();
+			return false;
+		}
+
+		const FVector3f EdgeA = Positions[I1] - Positions[I0];
+		const FVector3f EdgeB = Positions[I2] - Positions[I0];
+		const FVector3f Cross = FVector3f::CrossProduct(EdgeA, EdgeB);
+		const float Area = 0.5f * Cross.Size();
+
+		Origins.Add(Positions[I0]);
+		EdgesA.Add(EdgeA);
+		EdgesB.Add(EdgeB);
+		Normals.Add(Cross.GetSafeNormal());
+		SurfaceArea += Area;
+
+		float Weight = Area;
+		if (Channel != ERandomMeshWeightChannel::None)
+		{
+			Weight *= (ChannelWeight(VertexColors[I0], Channel) + ChannelWeight(VertexColors[I1], Channel) + ChannelWeight(VertexColors[I2], Channel)) / 3.0f;
+		}
+		Weights.Add(Weight);
+	}
+
+	if (!Triangles.Build(Weights))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomMeshSurfaceSampler::Build - Mesh has no triangle with a positive weight"));
+		Clear();
+		return false;
+	}
+	return true;
+}
+
+void RandomMeshSurfaceSampler::Clear()
+{
+	Origins.Reset();
+	EdgesA.Reset();
+	EdgesB.Reset();
+	Normals.Reset();
+	Triangles.Build(TArrayView<const float>());
+	SurfaceArea = 0.0f;
+}
+
+bool RandomMeshSurfaceSampler::BuildFromStaticMesh(const UStaticMesh& Mesh, const int32 LODIndex, const ERandomMeshWeightChannel WeightChannel)
+{
+	const FStaticMeshRenderData* RenderData = Mesh.GetRenderData();
+	if (RenderData == nullptr || !RenderData->LODResources.IsValidIndex(LODIndex))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomMeshSurfaceSampler::BuildFromStaticMesh - %s has no LOD %d"), *Mesh.GetName(), LODIndex);
+		return false;
+	}
+#if !WITH_EDITOR
+	if (!Mesh.bAllowCPUAccess)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomMeshSurfaceSampler::BuildFromStaticMesh - %s needs Allow CPU Access in cooked builds"), *Mesh.GetName());
+		return false;
+	}
+#endif
+
+	const FStaticMeshLODResources& LOD = RenderData->LODResources[LODIndex];
+	const FPositionVertexBuffer& PositionBuffer = LOD.VertexBuffers.PositionVertexBuffer;
+	const int32 VertexCount = static_cast<int32>(PositionBuffer.GetNumVertices());
+
+	TArray<FVector3f> Positions;
+	Positions.SetNumUninitialized(VertexCount);
+	for (int32 i = 0; i < VertexCount; ++i)
+	{
+		Positions[i] = PositionBuffer.VertexPosition(i);
+	}
+
+	TArray<FColor> Colors;
+	const FColorVertexBuffer& ColorBuffer = LOD.VertexBuffers.ColorVertexBuffer;
+	if (WeightChannel != ERandomMeshWeightChannel::None && static_cast<int32>(ColorBuffer.GetNumVertices()) == VertexCount)
+	{
+		Colors.SetNumUninitialized(VertexCount);
+		for (int32 i = 0; i < VertexCount; ++i)
+		{
+			Colors[i] = ColorBuffer.VertexColor(i);
+		}
+	}
+
+	TArray<uint32> Indices;
+	LOD.IndexBuffer.GetCopy(Indices);
+
+	return Build(Positions, Indices, Colors, WeightChannel);
+}
+
+FVector3f RandomMeshSurfaceSampler::PointFromRaw(const uint32 RawIndex, const uint32 RawCoin, const uint32 RawU, const uint32 RawV, int32& OutTriangleIndex) const
+{
+	const int32 Triangle = Triangles.Sample(RawIndex, RawCoin);
+	float U = RandomKernels::UnitFloat(RawU);
+	float V = RandomKernels::UnitFloat(RawV);
+
+	// Fold the upper half of the unit square back into the triangle (no square root)
+	const bool bFold = U + V > 1.0f;
+	U = bFold ? 1.0f - U : U;
+	V = bFold ? 1.0f - V : V;
+
+	OutTriangleIndex = Triangle;
+	return Origins[Triangle] + EdgesA[Triangle] * U + EdgesB[Triangle] * V;
+}
+
+FVector RandomMeshSurfaceSampler::RandPoint(RandomEngine& Engine, int32* OutTriangleIndex) const
+{
+	if (!IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomMeshSurfaceSampler::RandPoint - Sampler is not built"));
+		return FVector::ZeroVector;
+	}
+
+	uint32 Raw[4];
+	Engine.RandUInt32s(TArrayView<uint32>(Raw, 4));
+	int32 Triangle;
+	const FVector3f Point = PointFromRaw(Raw[0], Raw[1], Raw[2], Raw[3], Triangle);
+	if (OutTriangleIndex)
+	{
+		*OutTriangleIndex = Triangle;
+	}
+	return FVector(Point);
+}
+
+template <typename FWriter>
+void RandomMeshSurfaceSampler::GeneratePoints(RandomEngine& Engine, const int32 Count, FWriter&& Write) const
+{
+	using namespace RandomKernels;
+
+	uint32 Raw[ChunkSize * 4];
+	for (int32 Start = 0; Start < Count; Start += ChunkSize)
+	{
+		const int32 ChunkCount = FMath::Min(ChunkSize, Count - Start);
+		Engine.RandUInt32s(TArrayView<uint32>(Raw, ChunkCount * 4));
+		for (int32 i = 0; i < ChunkCount; ++i)
+		{
+			int32 Triangle;
+			const FVector3f Point = PointFromRaw(Raw[i], Raw[ChunkCount + i], Raw[2 * ChunkCount + i], Raw[3 * ChunkCount + i], Triangle);
+			Write(Start + i, Point, Triangle);
+		}
+	}
+}
+
+void RandomMeshSurfaceSampler::RandPoints(RandomEngine& Engine, TArrayView<float> OutX, TArrayView<float> OutY, TArrayView<float> OutZ, TArrayView<int32> OutTriangleIndices) const
+{
+	if (!IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomMeshSurfaceSampler::RandPoints - Sampler is not built"));
+		return;
+	}
+	if (OutX.Num() != OutY.Num() || OutX.Num() != OutZ.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomMeshSurfaceSampler::RandPoints - X/Y/Z arrays have different sizes"));
+	}
+	const int32 Count = FMath::Min3(OutX.Num(), OutY.Num(), OutZ.Num());
+	const bool bWriteTriangles = OutTriangleIndices.Num() >= Count;
+	GeneratePoints(Engine, Count, [&](const int32 Index, const FVector3f& Point, const int32 Triangle)
+	{
+		OutX[Index] = Point.X;
+		OutY[Index] = Point.Y;
+		OutZ[Index] = Point.Z;
+		if (bWriteTriangles)
+		{
+			OutTriangleIndices[Index] = Triangle;
+		}
+	});
+}
+
+void RandomMeshSurfaceSampler::RandPoints(RandomEngine& Engine, TArrayView<FVector> OutPoints, TArrayView<int32> OutTriangleIndices) const
+{
+	if (!IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomMeshSurfaceSampler::RandPoints - Sampler is not built"));
+		return;
+	}
+	const bool bWriteTriangles = OutTriangleIndices.Num() >= OutPoints.Num();
+	GeneratePoints(Engine, OutPoints.Num(), [&](const int32 Index, const FVector3f& Point, const int32 Triangle)
+	{
+		OutPoints[Index] = FVector(Point);
+		if (bWriteTriangles)
+		{
+			OutTriangleIndices[Index] = Triangle;
+		}
+	});
+}
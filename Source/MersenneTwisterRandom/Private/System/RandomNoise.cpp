@@ -0,0 +1,503 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "System/RandomNoise.h"
+#include "Async/ParallelFor.h"
+#include "System/RandomKernels.h"
+
+namespace RandomNoisePrivate
+{
+	/** Samples per side of the tiles filled by the parallel grid functions */
+	constexpr int32 GridTileSize = 64;
+
+
+	/** Gradient directions: square edges and diagonals (2D), cube edges (3D), tesseract edges (4D) */
+	constexpr float Gradients2[8][2] = {
+		{1, 1}, {-1, 1}, {1, -1}, {-1, -1}, {1, 0}, {-1, 0}, {0, 1}, {0, -1}
+	};
+	constexpr float Gradients3[16][3] = {
+		{1, 1, 0}, {-1, 1, 0}, {1, -1, 0}, {-1, -1, 0}, {1, 0, 1}, {-1, 0, 1}, {1, 0, -1}, {-1, 0, -1},
+		{0, 1, 1}, {0, -1, 1}, {0, 1, -1}, {0, -1, -1}, {1, 1, 0}, {-1, 1, 0}, {0, -1, 1}, {0, -1, -1}
+	};
+	constexpr float Gradients4[32][4] = {
+		{0, 1, 1, 1}, {0, 1, 1, -1}, {0, 1, -1, 1}, {0, 1, -1, -1}, {0, -1, 1, 1}, {0, -1, 1, -1}, {0, -1, -1, 1}, {0, -1, -1, -1},
+		{1, 0, 1, 1}, {1, 0, 1, -1}, {1, 0, -1, 1}, {1, 0, -1, -1}, {-1, 0, 1, 1}, {-1, 0, 1, -1}, {-1, 0, -1, 1}, {-1, 0, -1, -1},
+		{1, 1, 0, 1}, {1, 1, 0, -1}, {1, -1, 0, 1}, {1, -1, 0, -1}, {-1, 1, 0, 1}, {-1, 1, 0, -1}, {-1, -1, 0, 1}, {-1, -1, 0, -1},
+		{1, 1, 1, 0}, {1, 1, -1, 0}, {1, -1, 1, 0}, {1, -1, -1, 0}, {-1, 1, 1, 0}, {-1, 1, -1, 0}, {-1, -1, 1, 0}, {-1, -1, -1, 0}
+	};
+
+	/** Scales bringing the gradient noises to about [-1, 1] */
+	constexpr float PerlinScale[5] = {0.0f, 0.0f, 1.0f, 1.0f, 0.85f};
+	constexpr float SimplexScale[5] = {0.0f, 0.0f, 70.0f, 76.8f, 62.4f};
+
+	/** Dot product of a hashed gradient and an offset */
+	template <int32 D>
+	FORCEINLINE float GradientDot(const int32 Hash, const float (&Offset)[D])
+	{
+		const float* Gradient = D == 2 ? Gradients2[Hash & 7] : (D == 3 ? Gradients3[Hash & 15] : Gradients4[Hash & 31]);
+		float Dot = 0.0f;
+		for (int32 d = 0; d < D; ++d)
+		{
+			Dot += Gradient[d] * Offset[d];
+		}
+		return Dot;
+	}
+
+	/** Quintic fade, zero first and second derivatives at the lattice points */
+	FORCEINLINE float Fade(const float T)
+	{
+		return T * T * T * (T * (T * 6.0f - 15.0f) + 10.0f);
+	}
+
+	/** Splits a coordinate into its lattice cell (wrapped to the period) and the offset in the cell */
+	FORCEINLINE void SplitCoordinate(const double Coordinate, int32& OutCell, float& OutFraction)
+	{
+		const double Floor = FMath::FloorToDouble(Coordinate);
+		OutCell = static_cast<int32>(static_cast<int64>(Floor) & (RandomNoise::Period - 1));
+		OutFraction = static_cast<float>(Coordinate - Floor);
+	}
+
+	/** Reduces the 2^D corner values of a cell to one value, interpolating the highest axis first */
+	template <int32 D>
+	FORCEINLINE float Multilinear(float (&Corners)[1 << D], const float (&Weights)[D])
+	{
+		for (int32 d = D - 1; d >= 0; --d)
+		{
+			const int32 Half = 1 << d;
+			for (int32 i = 0; i < Half; ++i)
+			{
+				Corners[i] = FMath::Lerp(Corners[i], Corners[i + Half], Weights[d]);
+			}
+		}
+		return Corners[0];
+	}
+
+	/**
+	 * Lattice noise: a value per cell corner, blended with the quintic fade
+	 * @param Perm - Doubled permutation table
+	 * @param bGradient - Perlin gradients if true, random corner values otherwise
+	 */
+	template <int32 D>
+	float Lattice(const uint8* Perm, const int32 (&Cell)[D], const float (&Fraction)[D], const bool bGradient)
+	{
+		float Weights[D];
+		for (int32 d = 0; d < D; ++d)
+		{
+			Weights[d] = Fade(Fraction[d]);
+		}
+
+		float Corners[1 << D];
+		for (int32 Corner = 0; Corner < (1 << D); ++Corner)
+		{
+			int32 Hash = 0;
+			float Offset[D];
+			for (int32 d = 0; d < D; ++d)
+			{
+				const int32 Bit = (Corner >> d) & 1;
+				Hash = Perm[Hash + Cell[d] + Bit];
+				Offset[d] = Fraction[d] - Bit;
+			}
+			Corners[Corner] = bGradient ? GradientDot<D>(Hash, Offset) : Hash * (2.0f / 255.0f) - 1.0f;
+		}
+		const float Value = Multilinear<D>(Corners, Weights);
+		return bGradient ? Value * PerlinScale[D] : Value;
+	}
+
+	/**
+	 * Worley noise: distance to the nearest feature point, one point per cell
+	 * In 2D and 3D points lie anywhere in their cell and the 5^D neighbourhood is searched. That is
+	 * exact: the sample's own point is at most sqrt(3) < 2 away, while a point three or more cells
+	 * away is at least 2 away along that axis. Cells whose nearest possible point is farther than
+	 * the best distance so far are skipped before hashing, so most of the outer ring costs a few
+	 * compares. A 5^4 search would be too slow, so 4D keeps points in the middle third of their
+	 * cell and searches 3^4 cells: the own point is then at most 2/3 sqrt(4) = 4/3 away, and a
+	 * point two cells away more than 4/3. The 4D field is visibly more regular than 2D and 3D.
+	 */
+	template <int32 D>
+	float Worley(const uint8* Perm, const FVector4f* FeaturePoints, const int32 (&Cell)[D], const float (&Fraction)[D])
+	{
+		constexpr int32 Radius = D < 4 ? 2 : 1;
+		constexpr int32 Width = 2 * Radius + 1;
+		constexpr float JitterScale = D < 4 ? 1.0f : 1.0f / 3.0f;
+		constexpr float JitterBias = D < 4 ? 0.0f : 1.0f / 3.0f;
+
+		int32 Neighbours = 1;
+		for (int32 d = 0; d < D; ++d)
+		{
+			Neighbours *= Width;
+		}
+
+		float NearestSq = MAX_flt;
+		for (int32 Neighbour = 0; Neighbour < Neighbours; ++Neighbour)
+		{
+			// Lower bound of the distance to any point of the cell, from the gap along each axis
+			int32 Offsets[D];
+			float GapSq = 0.0f;
+			int32 Digits = Neighbour;
+			for (int32 d = 0; d < D; ++d)
+			{
+				Offsets[d] = Digits % Width - Radius;
+				Digits /= Width;
+				const float Gap = Offsets[d] > 0 ? Offsets[d] - Fraction[d] : Offsets[d] < 0 ? Fraction[d] - Offsets[d] - 1 : 0.0f;
+				GapSq += Gap * Gap;
+			}
+			if (GapSq >= NearestSq)
+			{
+				continue;
+			}
+
+			int32 Hash = 0;
+			for (int32 d = 0; d < D; ++d)
+			{
+				Hash = Perm[Hash + ((Cell[d] + Offsets[d]) & (RandomNoise::Period - 1))];
+			}
+			const FVector4f& Point = FeaturePoints[Hash];
+			float DistanceSq = 0.0f;
+			for (int32 d = 0; d < D; ++d)
+			{
+				const float Delta = Offsets[d] + JitterBias + JitterScale * Point[d] - Fraction[d];
+				DistanceSq += Delta * Delta;
+			}
+			NearestSq = FMath::Min(NearestSq, DistanceSq);
+		}
+		return FMath::Sqrt(NearestSq);
+	}
+
+	/**
+	 * Simplex noise (Perlin 2001, following Gustavson's "Simplex noise demystified")
+	 * The skewed cell is found in double precision, corners are ranked by sorting the offsets.
+	 */
+	template <int32 D>
+	float Simplex(const uint8* Perm, const double (&Coordinates)[D])
+	{
+		// Skew (F) and unskew (G) factors: (sqrt(D + 1) - 1) / D and (1 - 1 / sqrt(D + 1)) / D
+		const double Skew = (FMath::Sqrt(D + 1.0) - 1.0) / D;
+		const double Unskew = (1.0 - 1.0 / FMath::Sqrt(D + 1.0)) / D;
+
+		double Sum = 0.0;
+		for (int32 d = 0; d < D; ++d)
+		{
+			Sum += Coordinates[d];
+		}
+		const double SkewOffset = Sum * Skew;
+
+		double Base[D];
+		double BaseSum = 0.0;
+		for (int32 d = 0; d < D; ++d)
+		{
+			Base[d] = FMath::FloorToDouble(Coordinates[d] + SkewOffset);
+			BaseSum += Base[d];
+		}
+		const double UnskewOffset = BaseSum * Unskew;
+
+		int32 Cell[D];
+		float Offset[D];
+		for (int32 d = 0; d < D; ++d)
+		{
+			Cell[d] = static_cast<int32>(static_cast<int64>(Base[d]) & (RandomNoise::Period - 1));
+			Offset[d] = static_cast<float>(Coordinates[d] - (Base[d] - UnskewOffset));
+		}
+
+		// Rank of every axis: the simplex steps along the axes from the largest offset to the smallest
+		int32 Rank[D] = {};
+		for (int32 a = 0; a < D; ++a)
+		{
+			for (int32 b = a + 1; b < D; ++b)
+			{
+				++Rank[Offset[a] > Offset[b] ? a : b];
+			}
+		}
+
+		float Value = 0.0f;
+		for (int32 Corner = 0; Corner <= D; ++Corner)
+		{
+			int32 Hash = 0;
+			float CornerOffset[D];
+			float RadiusSq = 0.5f;
+			for (int32 d = 0; d < D; ++d)
+			{
+				// Corner k has stepped along the k axes of highest rank
+				const int32 Step = Rank[d] >= D - Corner ? 1 : 0;
+				Hash = Perm[Hash + Cell[d] + Step];
+				CornerOffset[d] = Offset[d] - Step + Corner * static_cast<float>(Unskew);
+				RadiusSq -= CornerOffset[d] * CornerOffset[d];
+			}
+			if (RadiusSq > 0.0f)
+			{
+				const float Falloff = RadiusSq * RadiusSq;
+				Value += Falloff * Falloff * GradientDot<D>(Hash, CornerOffset);
+			}
+		}
+		return Value * SimplexScale[D];
+	}
+}
+
+RandomNoise::RandomNoise(const ERandomNoiseType InType, RandomEngine& Engine): Type(InType)
+{
+	Initialize(Engine);
+}
+
+RandomNoise::RandomNoise(const ERandomNoiseType InType, const int32 InSeed): Type(InType)
+{
+	RandomEngine Engine(InSeed);
+	Initialize(Engine);
+}
+
+void RandomNoise::Initialize(RandomEngine& Engine)
+{
+	for (int32 i = 0; i < Period; ++i)
+	{
+		Permutation[i] = static_cast<uint8>(i);
+	}
+	// Only raw draws: std distributions differ between standard libraries, raw mt19937 output does not
+	for (int32 i = Period - 1; i > 0; --i)
+	{
+		Swap(Permutation[i], Permutation[RandomKernels::BoundedIndex(Engine, static_cast<uint32>(i + 1))]);
+	}
+	for (int32 i = 0; i < Period; ++i)
+	{
+		Permutation[Period + i] = Permutation[i];
+	}
+
+	// One draw per statement, argument evaluation order would make the tables compiler dependent
+	for (FVector4f& Point : FeaturePoints)
+	{
+		for (int32 d = 0; d < 4; ++d)
+		{
+			Point[d] = RandomKernels::UnitFloat(Engine.RandUInt32());
+		}
+	}
+
+	// The first octave stays in place so that one octave matches the Sample functions
+	OctaveOffsets[0] = FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+	for (int32 Octave = 1; Octave < MaxOctaves; ++Octave)
+	{
+		for (int32 d = 0; d < 4; ++d)
+		{
+			OctaveOffsets[Octave][d] = Period * RandomKernels::UnitFloat(Engine.RandUInt32());
+		}
+	}
+}
+
+template <int32 D>
+float RandomNoise::Evaluate(const double (&Coordinates)[D]) const
+{
+	using namespace RandomNoisePrivate;
+
+	if (Type == ERandomNoiseType::Simplex)
+	{
+		return Simplex<D>(Permutation, Coordinates);
+	}
+
+	int32 Cell[D];
+	float Fraction[D];
+	for (int32 d = 0; d < D; ++d)
+	{
+		SplitCoordinate(Coordinates[d], Cell[d], Fraction[d]);
+	}
+	switch (Type)
+	{
+	case ERandomNoiseType::Value:
+		return Lattice<D>(Permutation, Cell, Fraction, false);
+	case ERandomNoiseType::Worley:
+		return Worley<D>(Permutation, FeaturePoints, Cell, Fraction);
+	default:
+		return Lattice<D>(Permutation, Cell, Fraction, true);
+	}
+}
+
+/** Sums the octaves of fractal noise at a point */
+template <int32 D, typename FEvaluate>
+static float SumOctaves(const double (&Coordinates)[D], const RandomNoiseFractal& Fractal, const FVector4f* OctaveOffsets, FEvaluate&& Evaluate)
+{
+	const int32 Octaves = FMath::Clamp(Fractal.Octaves, 1, RandomNoise::MaxOctaves);
+	double Frequency = 1.0;
+	float Amplitude = 1.0f;
+	float Sum = 0.0f;
+	float Weight = 0.0f;
+	for (int32 Octave = 0; Octave < Octaves; ++Octave)
+	{
+		double Scaled[D];
+		for (int32 d = 0; d < D; ++d)
+		{
+			Scaled[d] = Coordinates[d] * Frequency + OctaveOffsets[Octave][d];
+		}
+		Sum += Amplitude * Evaluate(Scaled);
+		Weight += Amplitude;
+		Amplitude *= Fractal.Gain;
+		Frequency *= Fractal.Lacunarity;
+	}
+	return Weight != 0.0f ? Sum / Weight : 0.0f;
+}
+
+template <int32 D>
+void RandomNoise::FillRow(float* OutRow, const int32 FirstColumn, const int32 Count, const double (&RowOrigin)[D], const double Spacing, const RandomNoiseFractal& Fractal) const
+{
+	const int32 Octaves = FMath::Clamp(Fractal.Octaves, 1, MaxOctaves);
+	for (int32 i = 0; i < Count; ++i)
+	{
+		OutRow[i] = 0.0f;
+	}
+
+	double Frequency = 1.0;
+	float Amplitude = 1.0f;
+	float Weight = 0.0f;
+	for (int32 Octave = 0; Octave < Octaves; ++Octave)
+	{
+		// Everything but X is constant along the row
+		double Point[D];
+		for (int32 d = 0; d < D; ++d)
+		{
+			Point[d] = RowOrigin[d] * Frequency + OctaveOffsets[Octave][d];
+		}
+		const double StartX = Point[0];
+		const double StepX = Spacing * Frequency;
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Point[0] = StartX + (FirstColumn + i) * StepX;
+			OutRow[i] += Amplitude * Evaluate<D>(Point);
+		}
+		Weight += Amplitude;
+		Amplitude *= Fractal.Gain;
+		Frequency *= Fractal.Lacunarity;
+	}
+
+	const float InvWeight = Weight != 0.0f ? 1.0f / Weight : 0.0f;
+	for (int32 i = 0; i < Count; ++i)
+	{
+		OutRow[i] *= InvWeight;
+	}
+}
+
+float RandomNoise::Sample2D(const double X, const double Y) const
+{
+	const double Point[2] = {X, Y};
+	return Evaluate<2>(Point);
+}
+
+float RandomNoise::Sample3D(const double X, const double Y, const double Z) const
+{
+	const double Point[3] = {X, Y, Z};
+	return Evaluate<3>(Point);
+}
+
+float RandomNoise::Sample4D(const double X, const double Y, const double Z, const double W) const
+{
+	const double Point[4] = {X, Y, Z, W};
+	return Evaluate<4>(Point);
+}
+
+float RandomNoise::Fbm2D(const double X, const double Y, const RandomNoiseFractal& Fractal) const
+{
+	const double Point[2] = {X, Y};
+	return SumOctaves<2>(Point, Fractal, OctaveOffsets, [this](const double (&Scaled)[2]) { return Evaluate<2>(Scaled); });
+}
+
+float RandomNoise::Fbm3D(const double X, const double Y, const double Z, const RandomNoiseFractal& Fractal) const
+{
+	const double Point[3] = {X, Y, Z};
+	return SumOctaves<3>(Point, Fractal, OctaveOffsets, [this](const double (&Scaled)[3]) { return Evaluate<3>(Scaled); });
+}
+
+float RandomNoise::Fbm4D(const double X, const double Y, const double Z, const double W, const RandomNoiseFractal& Fractal) const
+{
+	const double Point[4] = {X, Y, Z, W};
+	return SumOctaves<4>(Point, Fractal, OctaveOffsets, [this](const double (&Scaled)[4]) { return Evaluate<4>(Scaled); });
+}
+
+/** Checks that a grid matches its output array, false if there is nothing to fill */
+static bool ValidateGrid(const TArrayView<float> OutValues, const int64 SampleCount, const bool bValidSize, const TCHAR* Function)
+{
+	if (!bValidSize)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomNoise::%s - Size must not be negative"), Function);
+		return false;
+	}
+	if (OutValues.Num() != SampleCount)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomNoise::%s - OutValues has %d elements, the grid has %lld"), Function, OutValues.Num(), SampleCount);
+		return false;
+	}
+	return SampleCount > 0;
+}
+
+void RandomNoise::FillGrid2D(TArrayView<float> OutValues, const FIntPoint Size, const FVector2D& Origin, const double Spacing, const RandomNoiseFractal& Fractal) const
+{
+	if (!ValidateGrid(OutValues, static_cast<int64>(Size.X) * Size.Y, Size.X >= 0 && Size.Y >= 0, TEXT("FillGrid2D")))
+	{
+		return;
+	}
+	for (int32 Y = 0; Y < Size.Y; ++Y)
+	{
+		const double RowOrigin[2] = {Origin.X, Origin.Y + Y * Spacing};
+		FillRow<2>(&OutValues[Y * Size.X], 0, Size.X, RowOrigin, Spacing, Fractal);
+	}
+}
+
+void RandomNoise::FillGrid2DParallel(TArrayView<float> OutValues, const FIntPoint Size, const FVector2D& Origin, const double Spacing, const RandomNoiseFractal& Fractal) const
+{
+	using namespace RandomNoisePrivate;
+
+	if (!ValidateGrid(OutValues, static_cast<int64>(Size.X) * Size.Y, Size.X >= 0 && Size.Y >= 0, TEXT("FillGrid2DParallel")))
+	{
+		return;
+	}
+	const int32 TilesX = FMath::DivideAndRoundUp(Size.X, GridTileSize);
+	const int32 TilesY = FMath::DivideAndRoundUp(Size.Y, GridTileSize);
+	ParallelFor(TilesX * TilesY, [&](const int32 Tile)
+	{
+		const int32 StartX = (Tile % TilesX) * GridTileSize;
+		const int32 StartY = (Tile / TilesX) * GridTileSize;
+		const int32 CountX = FMath::Min(GridTileSize, Size.X - StartX);
+		const int32 EndY = FMath::Min(StartY + GridTileSize, Size.Y);
+		for (int32 Y = StartY; Y < EndY; ++Y)
+		{
+			const double RowOrigin[2] = {Origin.X, Origin.Y + Y * Spacing};
+			FillRow<2>(&OutValues[Y * Size.X + StartX], StartX, CountX, RowOrigin, Spacing, Fractal);
+		}
+	});
+}
+
+void RandomNoise::FillGrid3D(TArrayView<float> OutValues, const FIntVector Size, const FVector& Origin, const double Spacing, const RandomNoiseFractal& Fractal) const
+{
+	if (!ValidateGrid(OutValues, static_cast<int64>(Size.X) * Size.Y * Size.Z, Size.X >= 0 && Size.Y >= 0 && Size.Z >= 0, TEXT("FillGrid3D")))
+	{
+		return;
+	}
+	for (int32 Z = 0; Z < Size.Z; ++Z)
+	{
+		for (int32 Y = 0; Y < Size.Y; ++Y)
+		{
+			const double RowOrigin[3] = {Origin.X, Origin.Y + Y * Spacing, Origin.Z + Z * Spacing};
+			FillRow<3>(&OutValues[(Z * Size.Y + Y) * Size.X], 0, Size.X, RowOrigin, Spacing, Fractal);
+		}
+	}
+}
+
+void RandomNoise::FillGrid3DParallel(TArrayView<float> OutValues, const FIntVector Size, const FVector& Origin, const double Spacing, const RandomNoiseFractal& Fractal) const
+{
+	using namespace RandomNoisePrivate;
+
+	if (!ValidateGrid(OutValues, static_cast<int64>(Size.X) * Size.Y * Size.Z, Size.X >= 0 && Size.Y >= 0 && Size.Z >= 0, TEXT("FillGrid3DParallel")))
+	{
+		return;
+	}
+
+	// Tiles are GridTileSize x GridTileSize samples of one Z slice
+	const int32 TilesX = FMath::DivideAndRoundUp(Size.X, GridTileSize);
+	const int32 TilesY = FMath::DivideAndRoundUp(Size.Y, GridTileSize);
+	ParallelFor(TilesX * TilesY * Size.Z, [&](const int32 Tile)
+	{
+		const int32 Z = Tile / (TilesX * TilesY);
+		const int32 SliceTile = Tile % (TilesX * TilesY);
+		const int32 StartX = (SliceTile % TilesX) * GridTileSize;
+		const int32 StartY = (SliceTile / TilesX) * GridTileSize;
+		const int32 CountX = FMath::Min(GridTileSize, Size.X - StartX);
+		const int32 EndY = FMath::Min(StartY + GridTileSize, Size.Y);
+		for (int32 Y = StartY; Y < EndY; ++Y)
+		{
+			const double RowOrigin[3] = {Origin.X, Origin.Y + Y * Spacing, Origin.Z + Z * Spacing};
+			FillRow<3>(&OutValues[(Z * Size.Y + Y) * Size.X + StartX], StartX, CountX, RowOrigin, Spacing, Fractal);
+		}
+	});
+}
@@ -0,0 +1,354 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include "System/RandomEngine.h"
+#include "System/RandomKernels.h"
+
+/**
+ * TPoissonDiskSampler - Bridson's Poisson-disk sampling in 2D or 3D
+ *
+ * Points are at least MinDistance apart. A background grid with cells of MinDistance / sqrt(D)
+ * holds at most one point per cell, so every distance check looks at a fixed neighbourhood
+ * and the whole fill runs in O(N).
+ *
+ * The grid stores point positions directly with an occupancy flag per cell, which lets the
+ * tiled mode fill non-adjacent tiles concurrently without any shared point list.
+ *
+ * @tparam D - Dimension, 2 or 3
+ * @tparam FInside - Predicate bool(const float (&)[D]) telling whether a point lies in the domain
+ */
+template <int32 D, typename FInside>
+class TPoissonDiskSampler
+{
+	static_assert(D == 2 || D == 3, "TPoissonDiskSampler supports 2D and 3D");
+
+public:
+	/** Position relative to the domain's bounding box minimum */
+	struct FPoint
+	{
+		float V[D];
+	};
+
+	/** Grid slot, a point and whether the cell holds one */
+	struct FCell
+	{
+		FPoint Point;
+		bool bOccupied;
+	};
+
+	/** Grid memory per cell, for callers bounding the grid size */
+	static constexpr int32 CellBytes = sizeof(FCell);
+
+	/**
+	 * @param InExtent - Size of the domain's bounding box on each axis
+	 * @param InMinDistance - Minimum distance between two points
+	 * @param InIsInside - Domain predicate, in bounding box relative coordinates
+	 */
+	TPoissonDiskSampler(const float (&InExtent)[D], const float InMinDistance, const FInside& InIsInside):
+		IsInside(InIsInside), MinDistance(InMinDistance), MinDistanceSq(InMinDistance * InMinDistance)
+	{
+		CellSize = MinDistance / FMath::Sqrt(static_cast<float>(D));
+		int64 CellCount = 1;
+		for (int32 Axis = 0; Axis < D; ++Axis)
+		{
+			Extent[Axis] = InExtent[Axis];
+			Dims[Axis] = FMath::Max(1, FMath::CeilToInt(Extent[Axis] / CellSize));
+			CellCount *= Dims[Axis];
+		}
+
+		Cells.SetNumZeroed(static_cast<int32>(CellCount));
+	}
+
+	/**
+	 * Fills the whole domain on the calling thread
+	 * @param Engine - Engine driving the candidate draws
+	 * @param MaxAttempts - Candidates tried around a point before it is retired (Bridson's k)
+	 * @param OutPoints - Receives the points in generation order
+	 */
+	void Fill(RandomEngine& Engine, const int32 MaxAttempts, TArray<FPoint>& OutPoints)
+	{
+		RandomKernels::FUniformStream Stream(Engine);
+		int32 RegionMin[D];
+		int32 RegionMax[D];
+		for (int32 Axis = 0; Axis < D; ++Axis)
+		{
+			RegionMin[Axis] = 0;
+			RegionMax[Axis] = Dims[Axis];
+		}
+		FillRegion(Stream, RegionMin, RegionMax, MaxAttempts, OutPoints);
+	}
+
+	/**
+	 * Fills the domain tile by tile on worker threads
+	 * Tiles are processed in 2^D phases so that two tiles running at the same time are never
+	 * neighbours. Every tile has its own engine derived from one draw of Engine and its index,
+	 * so the result only depends on the seed, not on the thread count.
+	 * @param Engine - Engine the tile seeds are derived from
+	 * @param MaxAttempts - Candidates tried around a point before it is retired (Bridson's k)
+	 * @param TileCells - Tile size in grid cells on each axis (at least 3)
+	 * @param OutPoints - Receives the points, tile by tile
+	 */
+	void FillTiled(RandomEngine& Engine, const int32 MaxAttempts, const int32 TileCells, TArray<FPoint>& OutPoints)
+	{
+		// A tile must be wider than the 2-cell neighbourhood a distance check reads
+		const int32 TileSize = FMath::Max(3, TileCells);
+		int32 TileDims[D];
+		int32 TileCount = 1;
+		for (int32 Axis = 0; Axis < D; ++Axis)
+		{
+			TileDims[Axis] = FMath::DivideAndRoundUp(Dims[Axis], TileSize);
+			TileCount *= TileDims[Axis];
+		}
+
+		const int32 BaseSeed = static_cast<int32>(Engine.RandUInt32());
+		const ERandomEngineBackend Backend = Engine.GetBackend();
+		TArray<TArray<FPoint>> TilePoints;
+		TilePoints.SetNum(TileCount);
+
+		for (int32 Phase = 0; Phase < (1 << D); ++Phase)
+		{
+			TArray<int32> PhaseTiles;
+			for (int32 TileIndex = 0; TileIndex < TileCount; ++TileIndex)
+			{
+				int32 Remainder = TileIndex;
+				int32 TilePhase = 0;
+				for (int32 Axis = 0; Axis < D; ++Axis)
+				{
+					TilePhase |= ((Remainder % TileDims[Axis]) & 1) << Axis;
+					Remainder /= TileDims[Axis];
+				}
+				if (TilePhase == Phase)
+				{
+					PhaseTiles.Add(TileIndex);
+				}
+			}
+
+			ParallelFor(PhaseTiles.Num(), [&](const int32 i)
+			{
+				const int32 TileIndex = PhaseTiles[i];
+				int32 RegionMin[D];
+				int32 RegionMax[D];
+				int32 Remainder = TileIndex;
+				for (int32 Axis = 0; Axis < D; ++Axis)
+				{
+					const int32 TileCoord = Remainder % TileDims[Axis];
+					Remainder /= TileDims[Axis];
+					RegionMin[Axis] = TileCoord * TileSize;
+					RegionMax[Axis] = FMath::Min(RegionMin[Axis] + TileSize, Dims[Axis]);
+				}
+
+				RandomEngine TileEngine(RandomEngine::StaticDeriveSeed(BaseSeed, static_cast<uint32>(TileIndex)), Backend);
+				RandomKernels::FUniformStream Stream(TileEngine);
+				FillRegion(Stream, RegionMin, RegionMax, MaxAttempts, TilePoints[TileIndex]);
+			});
+		}
+
+		for (TArray<FPoint>& Points : TilePoints)
+		{
+			OutPoints.Append(MoveTemp(Points));
+		}
+	}
+
+private:
+	const FInside& IsInside;
+	float MinDistance;
+	float MinDistanceSq;
+	float CellSize;
+	float Extent[D];
+	int32 Dims[D];
+
+	/** One slot per grid cell, tiles running at the same time write disjoint cells */
+	TArray<FCell> Cells;
+
+	int32 CellCoord(const float Value, const int32 Axis) const
+	{
+		return FMath::Clamp(static_cast<int32>(Value / CellSize), 0, Dims[Axis] - 1);
+	}
+
+	int32 CellIndex(const FPoint& Point) const
+	{
+		int32 Index = 0;
+		for (int32 Axis = D - 1; Axis >= 0; --Axis)
+		{
+			Index = Index * Dims[Axis] + CellCoord(Point.V[Axis], Axis);
+		}
+		return Index;
+	}
+
+	/** True when no existing point is closer than MinDistance */
+	bool IsFarEnough(const FPoint& Point) const
+	{
+		// Cells are MinDistance / sqrt(D) wide, so any conflicting point is at most 2 cells away
+		int32 Low[D];
+		int32 High[D];
+		for (int32 Axis = 0; Axis < D; ++Axis)
+		{
+			const int32 Coord = CellCoord(Point.V[Axis], Axis);
+			Low[Axis] = FMath::Max(Coord - 2, 0);
+			High[Axis] = FMath::Min(Coord + 2, Dims[Axis] - 1);
+		}
+
+		if constexpr (D == 2)
+		{
+			for (int32 Y = Low[1]; Y <= High[1]; ++Y)
+			{
+				for (int32 X = Low[0]; X <= High[0]; ++X)
+				{
+					if (IsConflict(Cells[Y * Dims[0] + X], Point))
+					{
+						return false;
+					}
+				}
+			}
+		}
+		else
+		{
+			for (int32 Z = Low[2]; Z <= High[2]; ++Z)
+			{
+				for (int32 Y = Low[1]; Y <= High[1]; ++Y)
+				{
+					for (int32 X = Low[0]; X <= High[0]; ++X)
+					{
+						if (IsConflict(Cells[(Z * Dims[1] + Y) * Dims[0] + X], Point))
+						{
+							return false;
+						}
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	bool IsConflict(const FCell& Cell, const FPoint& Point) const
+	{
+		if (!Cell.bOccupied)
+		{
+			return false;
+		}
+		float DistanceSq = 0.0f;
+		for (int32 Axis = 0; Axis < D; ++Axis)
+		{
+			const float Delta = Cell.Point.V[Axis] - Point.V[Axis];
+			DistanceSq += Delta * Delta;
+		}
+		return DistanceSq < MinDistanceSq;
+	}
+
+	/** Random offset with length in [MinDistance, 2 * MinDistance] */
+	FPoint RandAnnulusOffset(RandomKernels::FUniformStream& Stream) const
+	{
+		FPoint Offset;
+		if constexpr (D == 2)
+		{
+			// Area-uniform radius in the annulus
+			const float Length = MinDistance * FMath::Sqrt(1.0f + 3.0f * Stream.Next());
+			float Sin;
+			float Cos;
+			RandomKernels::SinCosTurns(Stream.Next(), Sin, Cos);
+			Offset.V[0] = Cos * Length;
+			Offset.V[1] = Sin * Length;
+		}
+		else
+		{
+			// Volume-uniform radius in the shell, Marsaglia direction
+			const float Length = 2.0f * MinDistance * RandomKernels::CubeRoot01((1.0f + 7.0f * Stream.Next()) * 0.125f);
+			float U;
+			float V;
+			float S;
+			do
+			{
+				U = Stream.NextSigned();
+				V = Stream.NextSigned();
+				S = U * U + V * V;
+			}
+			while (S >= 1.0f);
+			const float Scale = 2.0f * FMath::Sqrt(1.0f - S);
+			Offset.V[0] = U * Scale * Length;
+			Offset.V[1] = V * Scale * Length;
+			Offset.V[2] = (1.0f - 2.0f * S) * Length;
+		}
+		return Offset;
+	}
+
+	/** Bridson's fill restricted to the cells [RegionMin, RegionMax) */
+	void FillRegion(RandomKernels::FUniformStream& Stream, const int32 (&RegionMin)[D], const int32 (&RegionMax)[D], const int32 MaxAttempts, TArray<FPoint>& OutPoints)
+	{
+		float Low[D];
+		float High[D];
+		for (int32 Axis = 0; Axis < D; ++Axis)
+		{
+			Low[Axis] = RegionMin[Axis] * CellSize;
+			High[Axis] = FMath::Min(RegionMax[Axis] * CellSize, Extent[Axis]);
+		}
+
+		auto IsInRegion = [&](const FPoint& Point)
+		{
+			for (int32 Axis = 0; Axis < D; ++Axis)
+			{
+				if (Point.V[Axis] < Low[Axis] || Point.V[Axis] >= High[Axis])
+				{
+					return false;
+				}
+			}
+			return IsInside(Point.V);
+		};
+
+		TArray<FPoint> Active;
+		auto Accept = [&](const FPoint& Point)
+		{
+			FCell& Cell = Cells[CellIndex(Point)];
+			Cell.Point = Point;
+			Cell.bOccupied = true;
+			Active.Add(Point);
+			OutPoints.Add(Point);
+		};
+
+		// Several seeds: the region may be partly covered by neighbours or cut by the domain
+		const int32 SeedAttempts = FMath::Max(MaxAttempts, 1);
+		for (int32 Seed = 0; Seed < SeedAttempts; ++Seed)
+		{
+			FPoint Candidate;
+			for (int32 Axis = 0; Axis < D; ++Axis)
+			{
+				Candidate.V[Axis] = Low[Axis] + (High[Axis] - Low[Axis]) * Stream.Next();
+			}
+			if (!IsInRegion(Candidate) || !IsFarEnough(Candidate))
+			{
+				continue;
+			}
+			Accept(Candidate);
+
+			while (Active.Num() > 0)
+			{
+				const int32 ActiveIndex = FMath::Min(static_cast<int32>(Stream.Next() * Active.Num()), Active.Num() - 1);
+				const FPoint Origin = Active[ActiveIndex];
+
+				bool bFound = false;
+				for (int32 Attempt = 0; Attempt < MaxAttempts; ++Attempt)
+				{
+					const FPoint Offset = RandAnnulusOffset(Stream);
+					FPoint Next;
+					for (int32 Axis = 0; Axis < D; ++Axis)
+					{
+						Next.V[Axis] = Origin.V[Axis] + Offset.V[Axis];
+					}
+					if (IsInRegion(Next) && IsFarEnough(Next))
+					{
+						Accept(Next);
+						bFound = true;
+						break;
+					}
+				}
+
+				if (!bFound)
+				{
+					Active.RemoveAtSwap(ActiveIndex, 1, false);
+				}
+			}
+		}
+	}
+};
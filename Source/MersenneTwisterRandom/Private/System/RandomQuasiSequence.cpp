@@ -0,0 +1,207 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "System/RandomQuasiSequence.h"
+#include "System/RandomKernels.h"
+
+namespace RandomQuasiSequencePrivate
+{
+	/** Number of bits of a Sobol coordinate */
+	constexpr int32 SobolBits = 32;
+
+	/**
+	 * Sobol direction numbers for the first three dimensions (Joe & Kuo, new-joe-kuo-6.21201)
+	 * Dimension 0 is the van der Corput sequence, then polynomials x + 1 and x^2 + x + 1.
+	 */
+	struct FSobolDirections
+	{
+		uint32 V[RandomQuasiSequence::MaxDimensions][SobolBits];
+
+		FSobolDirections()
+		{
+			struct FPolynomial
+			{
+				int32 Degree;
+				uint32 Coefficients;
+				uint32 InitialM[2];
+			};
+			const FPolynomial Polynomials[RandomQuasiSequence::MaxDimensions - 1] = {
+				{1, 0, {1, 0}},
+				{2, 1, {1, 3}},
+			};
+
+			for (int32 Bit = 0; Bit < SobolBits; ++Bit)
+			{
+				V[0][Bit] = 1u << (31 - Bit);
+			}
+
+			for (int32 Dimension = 1; Dimension < RandomQuasiSequence::MaxDimensions; ++Dimension)
+			{
+				const FPolynomial& Polynomial = Polynomials[Dimension - 1];
+				const int32 S = Polynomial.Degree;
+				uint32* Directions = V[Dimension];
+				for (int32 Bit = 0; Bit < SobolBits; ++Bit)
+				{
+					if (Bit < S)
+					{
+						Directions[Bit] = Polynomial.InitialM[Bit] << (31 - Bit);
+						continue;
+					}
+					uint32 Value = Directions[Bit - S] ^ (Directions[Bit - S] >> S);
+					for (int32 k = 1; k < S; ++k)
+					{
+						if (((Polynomial.Coefficients >> (S - 1 - k)) & 1) != 0)
+						{
+							Value ^= Directions[Bit - k];
+						}
+					}
+					Directions[Bit] = Value;
+				}
+			}
+		}
+	};
+
+	const FSobolDirections& GetSobolDirections()
+	{
+		static const FSobolDirections Directions;
+		return Directions;
+	}
+
+	/** R2 increments (1 / phi_d^(j + 1)) as 64-bit fractions, for 2 and 3 dimensions */
+	constexpr uint64 R2Alpha[2][RandomQuasiSequence::MaxDimensions] = {
+		{0xC13FA9A902A6328Full, 0x91E10DA5C79E7B1Cull, 0},
+		{0xD1B54A32D192ED03ull, 0xABC98388FB8FAC02ull, 0x8CB92BA72F3D8DD7ull},
+	};
+
+	/** Halton bases, one prime per dimension */
+	constexpr uint32 HaltonBases[RandomQuasiSequence::MaxDimensions] = {2, 3, 5};
+
+	FORCEINLINE uint32 ReverseBits32(uint32 Bits)
+	{
+		Bits = (Bits << 16) | (Bits >> 16);
+		Bits = ((Bits & 0x00FF00FFu) << 8) | ((Bits & 0xFF00FF00u) >> 8);
+		Bits = ((Bits & 0x0F0F0F0Fu) << 4) | ((Bits & 0xF0F0F0F0u) >> 4);
+		Bits = ((Bits & 0x33333333u) << 2) | ((Bits & 0xCCCCCCCCu) >> 2);
+		Bits = ((Bits & 0x55555555u) << 1) | ((Bits & 0xAAAAAAAAu) >> 1);
+		return Bits;
+	}
+
+	/**
+	 * Owen scrambling with a hash (Burley, "Practical Hash-based Owen Scrambling", 2020)
+	 * Every bit is flipped depending only on the bits above it, which keeps the net properties.
+	 */
+	FORCEINLINE uint32 OwenScramble(uint32 Bits, const uint32 Seed)
+	{
+		Bits = ReverseBits32(Bits);
+		Bits += Seed;
+		Bits ^= Bits * 0x6C50B47Cu;
+		Bits ^= Bits * 0xB82F1E52u;
+		Bits ^= Bits * 0xC7AFE638u;
+		Bits ^= Bits * 0x8D22F6E6u;
+		return ReverseBits32(Bits);
+	}
+
+	FORCEINLINE uint32 Sobol(uint32 Index, const int32 Dimension)
+	{
+		const uint32* Directions = GetSobolDirections().V[Dimension];
+		uint32 Bits = 0;
+		for (int32 Bit = 0; Index != 0; Index >>= 1, ++Bit)
+		{
+			if ((Index & 1) != 0)
+			{
+				Bits ^= Directions[Bit];
+			}
+		}
+		return Bits;
+	}
+
+	/** Radical inverse of Index in a base, as a 32-bit fraction */
+	FORCEINLINE uint32 RadicalInverse(uint32 Index, const uint32 Base)
+	{
+		if (Base == 2)
+		{
+			return ReverseBits32(Index);
+		}
+		const double InvBase = 1.0 / Base;
+		double Factor = InvBase;
+		double Result = 0.0;
+		while (Index != 0)
+		{
+			Result += (Index % Base) * Factor;
+			Index /= Base;
+			Factor *= InvBase;
+		}
+		return static_cast<uint32>(FMath::Min(Result * 4294967296.0, 4294967295.0));
+	}
+}
+
+RandomQuasiSequence::RandomQuasiSequence(const ERandomQuasiSequence InType, RandomEngine& Engine): Type(InType)
+{
+	for (uint32& Value : Scramble)
+	{
+		Value = Engine.RandUInt32();
+	}
+}
+
+RandomQuasiSequence::RandomQuasiSequence(const ERandomQuasiSequence InType, const int32 InSeed): Type(InType)
+{
+	RandomEngine Engine(InSeed);
+	for (uint32& Value : Scramble)
+	{
+		Value = Engine.RandUInt32();
+	}
+}
+
+uint32 RandomQuasiSequence::GetBits(const uint32 Index, const int32 Dimension, const int32 Dimensions) const
+{
+	using namespace RandomQuasiSequencePrivate;
+
+	if (Dimension < 0 || Dimension >= MaxDimensions)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomQuasiSequence::GetBits - Dimension %d is out of range"), Dimension);
+		return 0;
+	}
+
+	switch (Type)
+	{
+	case ERandomQuasiSequence::Halton:
+		// Cranley-Patterson rotation: a toroidal shift, wraps around 2^32
+		return RadicalInverse(Index, HaltonBases[Dimension]) + Scramble[Dimension];
+	case ERandomQuasiSequence::R2:
+		{
+			// 64-bit fixed point keeps the recurrence exact far beyond float precision
+			const uint64 Alpha = R2Alpha[Dimensions <= 2 ? 0 : 1][Dimension];
+			return static_cast<uint32>((static_cast<uint64>(Index) * Alpha) >> 32) + Scramble[Dimension];
+		}
+	default:
+		return OwenScramble(Sobol(Index, Dimension), Scramble[Dimension]);
+	}
+}
+
+FVector2D RandomQuasiSequence::GetPoint2D(const uint32 Index) const
+{
+	using RandomKernels::UnitFloat;
+	return FVector2D(UnitFloat(GetBits(Index, 0, 2)), UnitFloat(GetBits(Index, 1, 2)));
+}
+
+FVector RandomQuasiSequence::GetPoint3D(const uint32 Index) const
+{
+	using RandomKernels::UnitFloat;
+	return FVector(UnitFloat(GetBits(Index, 0, 3)), UnitFloat(GetBits(Index, 1, 3)), UnitFloat(GetBits(Index, 2, 3)));
+}
+
+void RandomQuasiSequence::Fill2D(TArrayView<FVector2D> OutPoints, const uint32 StartIndex) const
+{
+	for (int32 i = 0; i < OutPoints.Num(); ++i)
+	{
+		OutPoints[i] = GetPoint2D(StartIndex + static_cast<uint32>(i));
+	}
+}
+
+void RandomQuasiSequence::Fill3D(TArrayView<FVector> OutPoints, const uint32 StartIndex) const
+{
+	for (int32 i = 0; i < OutPoints.Num(); ++i)
+	{
+		OutPoints[i] = GetPoint3D(StartIndex + static_cast<uint32>(i));
+	}
+}
@@ -0,0 +1,181 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "System/RandomSplineSampler.h"
+#include "System/RandomKernels.h"
+#include "Components/SplineComponent.h"
+
+bool RandomSplineSampler::Build(TArrayView<const FVector> InLocations, TArrayView<const FQuat> InRotations, const float InLength)
+{
+	Locations.Reset();
+	Rotations.Reset();
+	Length = 0.0f;
+
+	if (InLocations.Num() < 2 || InLocations.Num() != InRotations.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomSplineSampler::Build - Needs at least two locations and one rotation per location"));
+		return false;
+	}
+	if (InLength <= 0.0f)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomSplineSampler::Build - Path length is not positive"));
+		return false;
+	}
+
+	Locations.Append(InLocations.GetData(), InLocations.Num());
+	Rotations.Reserve(InRotations.Num());
+	for (const FQuat& Rotation : InRotations)
+	{
+		Rotations.Add(Rotation.GetNormalized());
+	}
+	Length = InLength;
+	return true;
+}
+
+bool RandomSplineSampler::BuildFromSpline(const USplineComponent& Spline, const float Spacing, const bool bWorldSpace)
+{
+	const float SplineLength = Spline.GetSplineLength();
+	if (SplineLength <= 0.0f || Spacing <= 0.0f)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomSplineSampler::BuildFromSpline - %s has no length or Spacing is not positive"), *Spline.GetName());
+		Locations.Reset();
+		Rotations.Reset();
+		Length = 0.0f;
+		return false;
+	}
+
+	const int32 Intervals = FMath::Clamp(FMath::CeilToInt(SplineLength / Spacing), 1, MaxFrames - 1);
+	const ESplineCoordinateSpace::Type Space = bWorldSpace ? ESplineCoordinateSpace::World : ESplineCoordinateSpace::Local;
+
+	// The spline's own reparameterization table turns distances into input keys
+	TArray<FVector> SplineLocations;
+	TArray<FQuat> SplineRotations;
+	SplineLocations.SetNumUninitialized(Intervals + 1);
+	SplineRotations.SetNumUninitialized(Intervals + 1);
+	for (int32 i = 0; i <= Intervals; ++i)
+	{
+		const float Distance = i == Intervals ? SplineLength : SplineLength * i / Intervals;
+		SplineLocations[i] = Spline.GetLocationAtDistanceAlongSpline(Distance, Space);
+		SplineRotations[i] = Spline.GetQuaternionAtDistanceAlongSpline(Distance, Space);
+	}
+	return Build(SplineLocations, SplineRotations, SplineLength);
+}
+
+void RandomSplineSampler::FrameAt(const float Position, FVector& OutLocation, FQuat& OutRotation) const
+{
+	const int32 Index = FMath::Min(static_cast<int32>(Position), Locations.Num() - 2);
+	const float Alpha = Position - Index;
+	OutLocation = FMath::Lerp(Locations[Index], Locations[Index + 1], Alpha);
+
+	// Neighbouring frames are close, normalized lerp is as good as slerp here
+	OutRotation = FQuat::FastLerp(Rotations[Index], Rotations[Index + 1], Alpha).GetNormalized();
+}
+
+FTransform RandomSplineSampler::GetTransformAtDistance(const float Distance) const
+{
+	if (!IsValid())
+	{
+		return FTransform::Identity;
+	}
+	const float Position = FMath::Clamp(Distance / Length, 0.0f, 1.0f) * (Locations.Num() - 1);
+	FVector Location;
+	FQuat Rotation;
+	FrameAt(Position, Location, Rotation);
+	return FTransform(Rotation, Location);
+}
+
+template <typename FWriter>
+void RandomSplineSampler::GenerateSamples(RandomEngine& Engine, const int32 Count, const float LateralOffset, FWriter&& Write) const
+{
+	using namespace RandomKernels;
+
+	// The offset draw is only taken when there is an offset
+	const bool bOffset = LateralOffset != 0.0f;
+	const int32 Draws = bOffset ? 2 : 1;
+	const float Scale = Locations.Num() - 1;
+
+	uint32 Raw[ChunkSize * 2];
+	for (int32 Start = 0; Start < Count; Start += ChunkSize)
+	{
+		const int32 ChunkCount = FMath::Min(ChunkSize, Count - Start);
+		Engine.RandUInt32s(TArrayView<uint32>(Raw, ChunkCount * Draws));
+		for (int32 i = 0; i < ChunkCount; ++i)
+		{
+			const float Unit = UnitFloat(Raw[i]);
+			FVector Location;
+			FQuat Rotation;
+			FrameAt(Unit * Scale, Location, Rotation);
+			if (bOffset)
+			{
+				const float Offset = (2.0f * UnitFloat(Raw[ChunkCount + i]) - 1.0f) * LateralOffset;
+				Location += Rotation.GetRightVector() * Offset;
+			}
+			Write(Start + i, Location, Rotation, Unit * Length);
+		}
+	}
+}
+
+FVector RandomSplineSampler::RandLocation(RandomEngine& Engine, const float LateralOffset, float* OutDistance) const
+{
+	if (!IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomSplineSampler::RandLocation - Sampler is not built"));
+		return FVector::ZeroVector;
+	}
+	FVector Result;
+	GenerateSamples(Engine, 1, LateralOffset, [&](const int32 Index, const FVector& Location, const FQuat& Rotation, const float Distance)
+	{
+		Result = Location;
+		if (OutDistance)
+		{
+			*OutDistance = Distance;
+		}
+	});
+	return Result;
+}
+
+FTransform RandomSplineSampler::RandTransform(RandomEngine& Engine, const float LateralOffset, const bool bAlignToTangent) const
+{
+	if (!IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomSplineSampler::RandTransform - Sampler is not built"));
+		return FTransform::Identity;
+	}
+	FTransform Result;
+	GenerateSamples(Engine, 1, LateralOffset, [&](const int32 Index, const FVector& Location, const FQuat& Rotation, const float Distance)
+	{
+		Result = FTransform(bAlignToTangent ? Rotation : FQuat::Identity, Location);
+	});
+	return Result;
+}
+
+void RandomSplineSampler::RandLocations(RandomEngine& Engine, TArrayView<FVector> OutLocations, const float LateralOffset, TArrayView<float> OutDistances) const
+{
+	if (!IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomSplineSampler::RandLocations - Sampler is not built"));
+		return;
+	}
+	const bool bWriteDistances = OutDistances.Num() >= OutLocations.Num();
+	GenerateSamples(Engine, OutLocations.Num(), LateralOffset, [&](const int32 Index, const FVector& Location, const FQuat& Rotation, const float Distance)
+	{
+		OutLocations[Index] = Location;
+		if (bWriteDistances)
+		{
+			OutDistances[Index] = Distance;
+		}
+	});
+}
+
+void RandomSplineSampler::RandTransforms(RandomEngine& Engine, TArrayView<FTransform> OutTransforms, const float LateralOffset, const bool bAlignToTangent) const
+{
+	if (!IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomSplineSampler::RandTransforms - Sampler is not built"));
+		return;
+	}
+	GenerateSamples(Engine, OutTransforms.Num(), LateralOffset, [&](const int32 Index, const FVector& Location, const FQuat& Rotation, const float Distance)
+	{
+		OutTransforms[Index] = FTransform(bAlignToTangent ? Rotation : FQuat::Identity, Location);
+	});
+}
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "System/RandomStreamRegistry.h"
+#include <atomic>
+
+namespace RandomStreamRegistryPrivate
+{
+	/** Next registry id, 0 is left to default constructed handles */
+	std::atomic<uint32> NextId{1};
+}
+
+RandomStreamRegistry::RandomStreamRegistry(): RandomStreamRegistry(RandomEngine::StaticNewSeed())
+{
+}
+
+RandomStreamRegistry::RandomStreamRegistry(int32 InRootSeed):
+	Id(RandomStreamRegistryPrivate::NextId.fetch_add(1, std::memory_order_relaxed)), RootSeed(InRootSeed)
+{
+}
+
+int32 RandomStreamRegistry::GetRootSeed() const
+{
+	return RootSeed;
+}
+
+uint32 RandomStreamRegistry::GetId() const
+{
+	return Id;
+}
+
+void RandomStreamRegistry::SetRootSeed(const int32 InRootSeed)
+{
+	RootSeed = InRootSeed;
+	for (int32 i = 0; i < Streams.Num(); ++i)
+	{
+		Streams[i] = RandomEngine(RandomEngine::StaticDeriveSeed(RootSeed, Names[i]), Streams[i].GetBackend());
+	}
+}
+
+int32 RandomStreamRegistry::FindOrAdd(const FName Name, const ERandomEngineBackend Backend)
+{
+	if (const int32* ExistingIndex = Indices.Find(Name))
+	{
+		return *ExistingIndex;
+	}
+
+	const int32 Index = Streams.Emplace(RandomEngine::StaticDeriveSeed(RootSeed, Name), Backend);
+	Names.Add(Name);
+	Indices.Add(Name, Index);
+	return Index;
+}
+
+RandomEngine* RandomStreamRegistry::Find(const int32 Index, const FName Name, const uint32 RegistryId)
+{
+	// The id rejects handles resolved on another registry, the name rejects slots a restored
+	// snapshot no longer holds
+	if (RegistryId == Id && Streams.IsValidIndex(Index) && Names[Index] == Name)
+	{
+		return &Streams[Index];
+	}
+	return nullptr;
+}
+
+RandomEngine& RandomStreamRegistry::Get(const int32 Index)
+{
+	return Streams[Index];
+}
+
+FName RandomStreamRegistry::GetName(const int32 Index) const
+{
+	return Names[Index];
+}
+
+int32 RandomStreamRegistry::Num() const
+{
+	return Streams.Num();
+}
+
+void RandomStreamRegistry::ResetAll()
+{
+	for (RandomEngine& Stream : Streams)
+	{
+		Stream.Reset();
+	}
+}
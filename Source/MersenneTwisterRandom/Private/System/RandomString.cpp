@@ -19,6 +19,15 @@ RandomString::RandomString(int32 InSeed) : Engine(InSeed)
 {
 }
 
+/**
+ * Constructor - Initializes the random engine with a specific seed and bit generator backend
+ * @param InSeed - The seed value for reproducible random generation
+ * @param InBackend - Bit generator backend of the engine
+ */
+RandomString::RandomString(int32 InSeed, ERandomEngineBackend InBackend) : Engine(InSeed, InBackend)
+{
+}
+
 /**
  * Destructor
  */
@@ -2,185 +2,1847 @@
 
 
 #include "System/RandomUtility.h"
+#include "System/RandomCurveSampler.h"
+#include "System/RandomKernels.h"
+#include "System/RandomMeshSurfaceSampler.h"
+#include "System/RandomPoissonDisk.h"
+#include "System/RandomSplineSampler.h"
+#include <cmath>
 
+/**
+ * Marsaglia (1972): a uniform point in the unit disk maps to a uniform point on the sphere
+ * @param NextSigned - Source of uniform floats in [-1, 1)
+ */
+template <typename FSource>
+static FVector SampleUnitSphereMarsaglia(FSource&& NextSigned)
+{
+	float U;
+	float V;
+	float S;
+	do
+	{
+		U = NextSigned();
+		V = NextSigned();
+		S = U * U + V * V;
+	}
+	while (S >= 1.0f);
+
+	const float Scale = 2.0f * FMath::Sqrt(1.0f - S);
+	return FVector(U * Scale, V * Scale, 1.0f - 2.0f * S);
+}
+
+/**
+ * Polar rejection: a uniform point in the unit disk, normalized, is uniform on the circle
+ * @param NextSigned - Source of uniform floats in [-1, 1)
+ */
+template <typename FSource>
+static FVector2D SampleUnitCirclePolar(FSource&& NextSigned)
+{
+	float U;
+	float V;
+	float S;
+	do
+	{
+		U = NextSigned();
+		V = NextSigned();
+		S = U * U + V * V;
+	}
+	while (S >= 1.0f || S < SMALL_NUMBER);
+
+	const float InvLength = FMath::InvSqrt(S);
+	return FVector2D(U * InvLength, V * InvLength);
+}
+
+/**
+ * Marsaglia (1972) 4D: two uniform points in the unit disk give a uniform point on the 3-sphere,
+ * the same distribution as normalizing four Gaussians without the logarithms
+ * @param NextSigned - Source of uniform floats in [-1, 1)
+ */
+template <typename FSource>
+static FQuat SampleUnitQuatMarsaglia(FSource&& NextSigned)
+{
+	float X;
+	float Y;
+	float S1;
+	do
+	{
+		X = NextSigned();
+		Y = NextSigned();
+		S1 = X * X + Y * Y;
+	}
+	while (S1 >= 1.0f);
+
+	float Z;
+	float W;
+	float S2;
+	do
+	{
+		Z = NextSigned();
+		W = NextSigned();
+		S2 = Z * Z + W * W;
+	}
+	while (S2 >= 1.0f || S2 < SMALL_NUMBER);
+
+	const float Scale = FMath::Sqrt((1.0f - S1) / S2);
+	return FQuat(X, Y, Z * Scale, W * Scale);
+}
+
+/** Tile size of the tiled Poisson-disk fill, in grid cells per axis */
+static constexpr int32 PoissonDiskTileCells2D = 64;
+static constexpr int32 PoissonDiskTileCells3D = 16;
+
+/** Largest background grid the Poisson-disk fill allocates, in bytes (12 bytes per cell in 2D, 16 in 3D) */
+static constexpr int64 PoissonDiskMaxGridBytes = 256ll << 20;
+
+/**
+ * Runs a Poisson-disk fill over a bounding box and hands every point to a writer
+ * @param Engine - Engine driving the fill
+ * @param Extent - Size of the domain's bounding box on each axis
+ * @param MinDistance - Minimum distance between two points
+ * @param MaxAttempts - Candidates tried around a point before giving up on it
+ * @param bTiled - Fill tiles in parallel
+ * @param IsInside - Domain predicate, in bounding box relative coordinates
+ * @param Emit - Called with every point, in bounding box relative coordinates
+ * @param FunctionName - Caller name for warnings
+ */
+template <int32 D, typename FInside, typename FEmit>
+static void GeneratePoissonDisk(RandomEngine& Engine, const float (&Extent)[D], const float MinDistance, const int32 MaxAttempts, const bool bTiled, const FInside& IsInside, FEmit&& Emit, const TCHAR* FunctionName)
+{
+	if (MinDistance <= 0.0f)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::%s - MinDistance must be positive"), FunctionName);
+		return;
+	}
+
+	const double CellSize = MinDistance / FMath::Sqrt(static_cast<double>(D));
+	double CellCount = 1.0;
+	for (int32 Axis = 0; Axis < D; ++Axis)
+	{
+		if (Extent[Axis] < 0.0f)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("RandomUtility::%s - Domain is empty"), FunctionName);
+			return;
+		}
+		CellCount *= FMath::Max(1.0, FMath::CeilToDouble(Extent[Axis] / CellSize));
+	}
+	using FSampler = TPoissonDiskSampler<D, FInside>;
+	if (CellCount > static_cast<double>(PoissonDiskMaxGridBytes / FSampler::CellBytes))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::%s - MinDistance is too small for the domain size"), FunctionName);
+		return;
+	}
+
+	FSampler Sampler(Extent, MinDistance, IsInside);
+	TArray<typename FSampler::FPoint> Points;
+	if (bTiled)
+	{
+		Sampler.FillTiled(Engine, FMath::Max(MaxAttempts, 1), D == 2 ? PoissonDiskTileCells2D : PoissonDiskTileCells3D, Points);
+	}
+	else
+	{
+		Sampler.Fill(Engine, FMath::Max(MaxAttempts, 1), Points);
+	}
+
+	for (const typename FSampler::FPoint& Point : Points)
+	{
+		Emit(Point.V);
+	}
+}
+
+/** Smallest GGX alpha, below it the lobe degenerates to a mirror direction */
+static constexpr float MinGGXAlpha = 1.0e-4f;
+
+/**
+ * Calls Body once with the unit square to +Z hemisphere map of a lobe, so batch loops are specialized per lobe
+ * @param Lobe - Direction distribution
+ * @param Shape - Phong exponent or GGX alpha
+ * @param Body - Called as Body(Map), Map is called as Map(U, V, OutX, OutY, OutZ)
+ */
+template <typename FBody>
+static void DispatchHemisphereLobe(const ERandomHemisphereLobe Lobe, const float Shape, FBody&& Body)
+{
+	using namespace RandomKernels;
+
+	switch (Lobe)
+	{
+	case ERandomHemisphereLobe::Uniform:
+		Body([](const float U, const float V, float& X, float& Y, float& Z) { SquareToHemisphere(U, V, X, Y, Z); });
+		break;
+	case ERandomHemisphereLobe::Phong:
+		{
+			const float InvExponentPlusOne = 1.0f / (FMath::Max(Shape, 0.0f) + 1.0f);
+			Body([InvExponentPlusOne](const float U, const float V, float& X, float& Y, float& Z) { SquareToPowerCosineHemisphere(U, V, InvExponentPlusOne, X, Y, Z); });
+			break;
+		}
+	case ERandomHemisphereLobe::GGX:
+		{
+			const float AlphaSq = FMath::Square(FMath::Max(Shape, MinGGXAlpha));
+			Body([AlphaSq](const float U, const float V, float& X, float& Y, float& Z) { SquareToGGXNormal(U, V, AlphaSq, X, Y, Z); });
+			break;
+		}
+	default:
+		Body([](const float U, const float V, float& X, float& Y, float& Z) { SquareToCosineHemisphere(U, V, X, Y, Z); });
+		break;
+	}
+}
+
+/** Orthonormal frame around a normal, local +Z maps to the normal */
+struct FHemisphereFrame
+{
+	FVector TangentA;
+	FVector TangentB;
+	FVector Normal;
+
+	explicit FHemisphereFrame(const FVector& InNormal)
+		: Normal(InNormal.GetSafeNormal(SMALL_NUMBER, FVector::UpVector))
+	{
+		Normal.FindBestAxisVectors(TangentA, TangentB);
+	}
+
+	FORCEINLINE FVector ToWorld(const float X, const float Y, const float Z) const
+	{
+		return TangentA * X + TangentB * Y + Normal * Z;
+	}
+};
+
+/**
+ * Generates hemisphere directions chunk by chunk from bulk raw draws
+ * @param Write - Called as Write(Start, ChunkCount, X, Y, Z) with world space components
+ */
+template <typename FWriter>
+static void GenerateHemisphereDirections(RandomEngine& Engine, const int32 Count, const FVector& Normal, const ERandomHemisphereLobe Lobe, const float Shape, FWriter&& Write)
+{
+	using namespace RandomKernels;
+
+	const FHemisphereFrame Frame(Normal);
+	const FVector3f A(Frame.TangentA);
+	const FVector3f B(Frame.TangentB);
+	const FVector3f N(Frame.Normal);
+
+	DispatchHemisphereLobe(Lobe, Shape, [&](auto&& Map)
+	{
+		uint32 Raw[ChunkSize * 2];
+		float X[ChunkSize];
+		float Y[ChunkSize];
+		float Z[ChunkSize];
+		for (int32 Start = 0; Start < Count; Start += ChunkSize)
+		{
+			const int32 ChunkCount = FMath::Min(ChunkSize, Count - Start);
+			Engine.RandUInt32s(TArrayView<uint32>(Raw, ChunkCount * 2));
+			for (int32 i = 0; i < ChunkCount; ++i)
+			{
+				float LocalX;
+				float LocalY;
+				float LocalZ;
+				Map(UnitFloat(Raw[i]), UnitFloat(Raw[ChunkCount + i]), LocalX, LocalY, LocalZ);
+				X[i] = A.X * LocalX + B.X * LocalY + N.X * LocalZ;
+				Y[i] = A.Y * LocalX + B.Y * LocalY + N.Y * LocalZ;
+				Z[i] = A.Z * LocalX + B.Z * LocalY + N.Z * LocalZ;
+			}
+			Write(Start, ChunkCount, X, Y, Z);
+		}
+	});
+}
+
+/** Most raw draws a generated transform consumes: three for the position, rotation and scale each */
+static constexpr int32 MaxTransformDraws = 9;
+
+/**
+ * Generates transforms chunk by chunk from bulk raw draws
+ * Every transform consumes the same number of draws, laid out per transform.
+ * @param Write - Called as Write(Index, Translation, Rotation, Scale)
+ */
+template <typename FWriter>
+static void GenerateTransforms(RandomEngine& Engine, const int32 Count, const RandomTransformSettings& Settings, FWriter&& Write)
+{
+	using namespace RandomKernels;
+
+	const int32 RotationDraws = Settings.Rotation == ERandomTransformRotation::Full ? 3 : (Settings.Rotation == ERandomTransformRotation::Yaw ? 1 : 0);
+	const int32 ScaleDraws = Settings.bUniformScale ? 1 : 3;
+	const int32 Draws = 3 + RotationDraws + ScaleDraws;
+	const FVector BoxSize = Settings.Bounds.Max - Settings.Bounds.Min;
+	const FVector ScaleRange = Settings.MaxScale - Settings.MinScale;
+
+	uint32 Raw[ChunkSize * MaxTransformDraws];
+	for (int32 Start = 0; Start < Count; Start += ChunkSize)
+	{
+		const int32 ChunkCount = FMath::Min(ChunkSize, Count - Start);
+		Engine.RandUInt32s(TArrayView<uint32>(Raw, ChunkCount * Draws));
+		for (int32 i = 0; i < ChunkCount; ++i)
+		{
+			const uint32* Draw = Raw + i * Draws;
+
+			FVector Translation;
+			float X;
+			float Y;
+			float Z;
+			switch (Settings.Volume)
+			{
+			case ERandomTransformVolume::Sphere:
+				CubeToBall(UnitFloat(Draw[0]), UnitFloat(Draw[1]), UnitFloat(Draw[2]), X, Y, Z);
+				Translation = Settings.Center + FVector(X, Y, Z) * Settings.Radius;
+				break;
+			case ERandomTransformVolume::Disk:
+				SquareToDisk(UnitFloat(Draw[0]), UnitFloat(Draw[1]), X, Y);
+				Translation = Settings.Center + FVector(X * Settings.Radius, Y * Settings.Radius, 0.0f);
+				break;
+			default:
+				Translation = Settings.Bounds.Min + BoxSize * FVector(UnitFloat(Draw[0]), UnitFloat(Draw[1]), UnitFloat(Draw[2]));
+				break;
+			}
+			Draw += 3;
+
+			FQuat Rotation = FQuat::Identity;
+			if (RotationDraws == 3)
+			{
+				// Shoemake: uniform over SO(3) from one uniform split and two angles
+				const float Split = UnitFloat(Draw[0]);
+				const float A = FMath::Sqrt(1.0f - Split);
+				const float B = FMath::Sqrt(Split);
+				float SinA;
+				float CosA;
+				float SinB;
+				float CosB;
+				SinCosTurns(UnitFloat(Draw[1]), SinA, CosA);
+				SinCosTurns(UnitFloat(Draw[2]), SinB, CosB);
+				Rotation = FQuat(A * SinA, A * CosA, B * SinB, B * CosB);
+			}
+			else if (RotationDraws == 1)
+			{
+				// Half of a full turn of yaw around +Z
+				float SinHalf;
+				float CosHalf;
+				SinCosTurns(0.5f * UnitFloat(Draw[0]), SinHalf, CosHalf);
+				Rotation = FQuat(0.0f, 0.0f, SinHalf, CosHalf);
+			}
+			Draw += RotationDraws;
+
+			const FVector Scale = Settings.bUniformScale
+				? Settings.MinScale + ScaleRange * UnitFloat(Draw[0])
+				: Settings.MinScale + ScaleRange * FVector(UnitFloat(Draw[0]), UnitFloat(Draw[1]), UnitFloat(Draw[2]));
+
+			Write(Start + i, Translation, Rotation, Scale);
+		}
+	}
+}
+
+/** Warns about settings that cannot produce the expected transforms */
+static void ValidateTransformSettings(const RandomTransformSettings& Settings, const TCHAR* Function)
+{
+	if (Settings.Volume == ERandomTransformVolume::Box && !Settings.Bounds.IsValid)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::%s - Bounds is not valid"), Function);
+	}
+	if (Settings.Volume != ERandomTransformVolume::Box && Settings.Radius < 0.0f)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::%s - Radius is negative"), Function);
+	}
+}
+
+/** Checks that separate translation, rotation and scale arrays match, returns the number of transforms to write */
+static int32 ValidateTransformArrays(TArrayView<FVector> OutTranslations, TArrayView<FQuat> OutRotations, TArrayView<FVector> OutScales, const TCHAR* Function)
+{
+	if (OutTranslations.Num() != OutRotations.Num() || OutTranslations.Num() != OutScales.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::%s - Translation/rotation/scale arrays have different sizes"), Function);
+	}
+	return FMath::Min3(OutTranslations.Num(), OutRotations.Num(), OutScales.Num());
+}
+
+/** Most Gaussian values a walk step consumes: a direction and the two values of a Levy length */
+static constexpr int32 MaxWalkGaussians = 5;
+
+/**
+ * Scale of the numerator of Mantegna's Levy step u / |v|^(1 / Alpha), u and v standard normal
+ * Makes the step length follow a symmetric stable law of index Alpha in its tails.
+ */
+static float MantegnaSigma(const float Alpha)
+{
+	const double A = Alpha;
+	const double Numerator = std::tgamma(1.0 + A) * FMath::Sin(UE_PI * A / 2.0);
+	const double Denominator = std::tgamma((1.0 + A) / 2.0) * A * FMath::Pow(2.0, (A - 1.0) / 2.0);
+	return static_cast<float>(FMath::Pow(Numerator / Denominator, 1.0 / A));
+}
+
+/** Folds a value into [Min, Max] by mirroring it off the bounds as many times as needed */
+static FORCEINLINE double ReflectIntoRange(const double Value, const double Min, const double Max)
+{
+	const double Range = Max - Min;
+	if (Range <= 0.0)
+	{
+		return Min;
+	}
+	double Offset = FMath::Fmod(Value - Min, 2.0 * Range);
+	Offset = Offset < 0.0 ? Offset + 2.0 * Range : Offset;
+	return Min + (Offset > Range ? 2.0 * Range - Offset : Offset);
+}
+
+/**
+ * Generates a D-dimensional random walk chunk by chunk
+ * Steps of a chunk are first drawn and scaled from bulk Gaussian values, then accumulated
+ * (a running sum for Gaussian and Levy walks, the reflecting or mean-reverting recurrence otherwise).
+ * @param Write - Called as Write(StepIndex, Position) with the position after the step
+ */
+template <int32 D, typename FWriter>
+static void GenerateWalk(RandomEngine& Engine, const int32 Count, const double (&Start)[D], const RandomWalkSettings& Settings, FWriter&& Write)
+{
+	using namespace RandomKernels;
+
+	const ERandomWalk Type = Settings.Type;
+	const float TimeStep = FMath::Max(Settings.TimeStep, 0.0f);
+	const float Alpha = FMath::Clamp(Settings.LevyAlpha, 0.1f, 1.99f);
+	const int32 GaussiansPerStep = Type == ERandomWalk::Levy ? (D == 1 ? 2 : D + 2) : D;
+
+	// Per-step scale of the Gaussian values
+	float Scale = Settings.StepSize * FMath::Sqrt(TimeStep);
+	float Decay = 1.0f;
+	if (Type == ERandomWalk::Levy)
+	{
+		Scale = Settings.StepSize * FMath::Pow(TimeStep, 1.0f / Alpha) * MantegnaSigma(Alpha);
+	}
+	else if (Type == ERandomWalk::OrnsteinUhlenbeck && Settings.ReversionRate > 0.0f)
+	{
+		// Exact discretization: the variance of the noise accumulated over one step
+		Decay = FMath::Exp(-Settings.ReversionRate * TimeStep);
+		Scale = Settings.StepSize * FMath::Sqrt((1.0f - Decay * Decay) / (2.0f * Settings.ReversionRate));
+	}
+
+	// Positions accumulate in double so long paths keep their precision far from the origin
+	double Position[D];
+	for (int32 d = 0; d < D; ++d)
+	{
+		Position[d] = Start[d];
+	}
+
+	float Gaussians[ChunkSize * MaxWalkGaussians];
+	float Steps[ChunkSize * D];
+	for (int32 ChunkStart = 0; ChunkStart < Count; ChunkStart += ChunkSize)
+	{
+		const int32 ChunkCount = FMath::Min(ChunkSize, Count - ChunkStart);
+		FillGaussians(Engine, Gaussians, ChunkCount * GaussiansPerStep);
+
+		if (Type != ERandomWalk::Levy)
+		{
+			for (int32 i = 0; i < ChunkCount * D; ++i)
+			{
+				Steps[i] = Gaussians[i] * Scale;
+			}
+		}
+		else
+		{
+			const float InvAlpha = 1.0f / Alpha;
+			for (int32 i = 0; i < ChunkCount; ++i)
+			{
+				const float* Values = Gaussians + i * GaussiansPerStep;
+				const float Denominator = FMath::Pow(FMath::Max(FMath::Abs(Values[GaussiansPerStep - 1]), 1.0e-6f), InvAlpha);
+				const float Length = Scale * Values[GaussiansPerStep - 2] / Denominator;
+				if (D == 1)
+				{
+					Steps[i * D] = Length;
+					continue;
+				}
+
+				// A normalized Gaussian vector is a uniform direction
+				float LengthSq = 0.0f;
+				for (int32 d = 0; d < D; ++d)
+				{
+					LengthSq += Values[d] * Values[d];
+				}
+				const float InvLength = LengthSq > SMALL_NUMBER ? FMath::InvSqrt(LengthSq) : 0.0f;
+				for (int32 d = 0; d < D; ++d)
+				{
+					Steps[i * D + d] = FMath::Abs(Length) * Values[d] * InvLength;
+				}
+			}
+		}
+
+		for (int32 i = 0; i < ChunkCount; ++i)
+		{
+			for (int32 d = 0; d < D; ++d)
+			{
+				const float Step = Steps[i * D + d];
+				switch (Type)
+				{
+				case ERandomWalk::Bounded:
+					Position[d] = ReflectIntoRange(Position[d] + Step, Settings.MinBound[d], Settings.MaxBound[d]);
+					break;
+				case ERandomWalk::OrnsteinUhlenbeck:
+					Position[d] = Settings.Mean[d] + (Position[d] - Settings.Mean[d]) * Decay + Step;
+					break;
+				default:
+					Position[d] += Step;
+					break;
+				}
+			}
+			Write(ChunkStart + i, Position);
+		}
+	}
+}
+
+/** Warns about walk settings that cannot produce the expected paths */
+static void ValidateWalkSettings(const RandomWalkSettings& Settings, const int32 Dimensions)
+{
+	if (Settings.Type == ERandomWalk::Bounded)
+	{
+		for (int32 d = 0; d < Dimensions; ++d)
+		{
+			if (Settings.MinBound[d] > Settings.MaxBound[d])
+			{
+				UE_LOG(LogTemp, Warning, TEXT("RandomUtility::RandWalk - MinBound is larger than MaxBound, positions are pinned to MinBound"));
+				return;
+			}
+		}
+	}
+	if (Settings.TimeStep < 0.0f)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::RandWalk - TimeStep is negative"));
+	}
+}
+
+/**
+ * Fills an array from a sampler driven by buffered bulk raw draws
+ * @param Engine - Engine providing the draws
+ * @param OutValues - Array to fill, every element is overwritten
+ * @param Sample - Called as Sample(Next) for every element, Next returns uniform floats in [0, 1)
+ */
+template <typename T, typename FSampler>
+static void FillFromStream(RandomEngine& Engine, TArrayView<T> OutValues, FSampler&& Sample)
+{
+	RandomKernels::FUniformStream Stream(Engine);
+	auto Next = [&Stream]() { return Stream.Next(); };
+	for (T& Value : OutValues)
+	{
+		Value = Sample(Next);
+	}
+}
+
+/**
+ * Uniform point in or on a box centered at the origin
+ * Surface points pick a face pair by area, then the sign of the same coordinate picks the face.
+ * @param Extent - Half size of the box
+ * @param bSurface - Whether the point lies on the faces or fills the volume
+ * @param Next - Source of uniform floats in [0, 1)
+ */
+template <typename FSource>
+static FVector SampleBoxLocal(const FVector& Extent, const bool bSurface, FSource&& Next)
+{
+	const float UnitX = 2.0f * Next() - 1.0f;
+	const float UnitY = 2.0f * Next() - 1.0f;
+	const float UnitZ = 2.0f * Next() - 1.0f;
+	FVector Point(UnitX * Extent.X, UnitY * Extent.Y, UnitZ * Extent.Z);
+	if (bSurface)
+	{
+		const double AreaX = Extent.Y * Extent.Z;
+		const double AreaY = Extent.X * Extent.Z;
+		const double AreaZ = Extent.X * Extent.Y;
+		const double Pick = Next() * (AreaX + AreaY + AreaZ);
+		const int32 Axis = Pick < AreaX ? 0 : (Pick < AreaX + AreaY ? 1 : 2);
+		Point[Axis] = Point[Axis] < 0.0 ? -Extent[Axis] : Extent[Axis];
+	}
+	return Point;
+}
+
+/**
+ * Uniform point in or on a capsule
+ * The cylinder and the two hemispheres are picked by volume (or area), the hemispheres are
+ * sampled as one sphere whose halves go to either end.
+ * @param Next - Source of uniform floats in [0, 1)
+ */
+template <typename FSource>
+static FVector SampleCapsule(const FVector& Start, const FVector& End, const float Radius, const bool bSurface, FSource&& Next)
+{
+	const FVector Axis = End - Start;
+	const float Height = Axis.Size();
+	const FVector Direction = Height > KINDA_SMALL_NUMBER ? Axis / Height : FVector::UpVector;
+	FVector TangentA;
+	FVector TangentB;
+	Direction.FindBestAxisVectors(TangentA, TangentB);
+
+	// Cylinder share: PI r^2 h against 4/3 PI r^3 (volume), 2 PI r h against 4 PI r^2 (surface)
+	const float Round = bSurface ? 2.0f * Radius : (4.0f / 3.0f) * Radius;
+	const float CylinderShare = Height / FMath::Max(Height + Round, SMALL_NUMBER);
+
+	float X;
+	float Y;
+	float Z;
+	if (Next() < CylinderShare)
+	{
+		const float Along = Next() * Height;
+		if (bSurface)
+		{
+			RandomKernels::SinCosTurns(Next(), Y, X);
+		}
+		else
+		{
+			const float U = Next();
+			const float V = Next();
+			RandomKernels::SquareToDisk(U, V, X, Y);
+		}
+		return Start + Direction * Along + (TangentA * X + TangentB * Y) * Radius;
+	}
+
+	if (bSurface)
+	{
+		const float U = Next();
+		const float V = Next();
+		RandomKernels::SquareToSphere(U, V, X, Y, Z);
+	}
+	else
+	{
+		const float U = Next();
+		const float V = Next();
+		const float W = Next();
+		RandomKernels::CubeToBall(U, V, W, X, Y, Z);
+	}
+	const FVector& Center = Z > 0.0f ? End : Start;
+	return Center + (TangentA * X + TangentB * Y + Direction * Z) * Radius;
+}
+
+/**
+ * Uniform point in or on a cone
+ * Volume: the distance from the apex follows the cube root (cross sections grow as t^2).
+ * Surface: the lateral surface and the base are picked by area, the lateral distance follows the square root.
+ * @param Next - Source of uniform floats in [0, 1)
+ */
+template <typename FSource>
+static FVector SampleCone(const FVector& Apex, const FVector& Direction, const float Height, const float BaseRadius, const bool bSurface, FSource&& Next)
+{
+	const FVector Axis = Direction.GetSafeNormal(SMALL_NUMBER, FVector::UpVector);
+	FVector TangentA;
+	FVector TangentB;
+	Axis.FindBestAxisVectors(TangentA, TangentB);
+
+	float T;
+	float X;
+	float Y;
+	if (!bSurface)
+	{
+		T = RandomKernels::CubeRoot01(Next());
+		const float U = Next();
+		const float V = Next();
+		RandomKernels::SquareToDisk(U, V, X, Y);
+	}
+	else
+	{
+		// Lateral area PI R L against base area PI R^2
+		const float Slant = FMath::Sqrt(BaseRadius * BaseRadius + Height * Height);
+		const float LateralShare = Slant / FMath::Max(Slant + BaseRadius, SMALL_NUMBER);
+		if (Next() < LateralShare)
+		{
+			T = FMath::Sqrt(Next());
+			RandomKernels::SinCosTurns(Next(), Y, X);
+		}
+		else
+		{
+			T = 1.0f;
+			const float U = Next();
+			const float V = Next();
+			RandomKernels::SquareToDisk(U, V, X, Y);
+		}
+	}
+	return Apex + Axis * (T * Height) + (TangentA * X + TangentB * Y) * (T * BaseRadius);
+}
+
+/**
+ * Uniform direction in a cone around an axis: uniform height on the unit sphere above cos(HalfAngle)
+ * @param Next - Source of uniform floats in [0, 1)
+ */
+template <typename FSource>
+static FVector SampleSphericalCap(const FVector& Direction, const float CosHalfAngle, FSource&& Next)
+{
+	const FVector Axis = Direction.GetSafeNormal(SMALL_NUMBER, FVector::UpVector);
+	FVector TangentA;
+	FVector TangentB;
+	Axis.FindBestAxisVectors(TangentA, TangentB);
+
+	const float Z = 1.0f - Next() * (1.0f - CosHalfAngle);
+	const float Ring = FMath::Sqrt(FMath::Max(0.0f, 1.0f - Z * Z));
+	float Sin;
+	float Cos;
+	RandomKernels::SinCosTurns(Next(), Sin, Cos);
+	return TangentA * (Cos * Ring) + TangentB * (Sin * Ring) + Axis * Z;
+}
+
+/**
+ * Uniform point in a ring: the squared radius is uniform between the two squared radii
+ * @param Next - Source of uniform floats in [0, 1)
+ */
+template <typename FSource>
+static FVector2D SampleAnnulus(const float InnerRadius, const float OuterRadius, FSource&& Next)
+{
+	const float InnerSq = InnerRadius * InnerRadius;
+	const float Radius = FMath::Sqrt(InnerSq + Next() * (OuterRadius * OuterRadius - InnerSq));
+	float Sin;
+	float Cos;
+	RandomKernels::SinCosTurns(Next(), Sin, Cos);
+	return FVector2D(Cos * Radius, Sin * Radius);
+}
+
+/**
+ * Splits the unit square into Count strata of area 1 / Count and visits them row by row
+ * Rows hold Count / Rows or one more cells, and each row is as tall as its share of the
+ * cells, so every stratum has the same area for any Count.
+ * @param Count - Number of strata
+ * @param Visit - Called with (StratumIndex, MinU, MinV, Width, Height)
+ */
+template <typename FVisitor>
+static void ForEachStratum2D(const int32 Count, FVisitor&& Visit)
+{
+	const int32 Rows = FMath::Max(1, FMath::FloorToInt(FMath::Sqrt(static_cast<float>(Count))));
+	const int32 BaseColumns = Count / Rows;
+	const int32 ExtraColumns = Count % Rows;
+
+	int32 Index = 0;
+	for (int32 Row = 0; Row < Rows; ++Row)
+	{
+		const int32 Columns = BaseColumns + (Row < ExtraColumns ? 1 : 0);
+		const float MinV = static_cast<float>(Index) / Count;
+		const float Height = static_cast<float>(Columns) / Count;
+		const float Width = 1.0f / Columns;
+		for (int32 Column = 0; Column < Columns; ++Column, ++Index)
+		{
+			Visit(Index, Column * Width, MinV, Width, Height);
+		}
+	}
+}
+
+/**
+ * Splits the unit cube into Count strata of volume 1 / Count: layers as thick as their share
+ * of the strata, each split with ForEachStratum2D
+ * @param Count - Number of strata
+ * @param Visit - Called with (StratumIndex, MinU, MinV, MinW, Width, Height, Depth)
+ */
+template <typename FVisitor>
+static void ForEachStratum3D(const int32 Count, FVisitor&& Visit)
+{
+	const int32 Layers = FMath::Max(1, FMath::RoundToInt(FMath::Pow(static_cast<float>(Count), 1.0f / 3.0f)));
+	const int32 BaseCount = Count / Layers;
+	const int32 ExtraCount = Count % Layers;
+
+	int32 Start = 0;
+	for (int32 Layer = 0; Layer < Layers; ++Layer)
+	{
+		const int32 LayerCount = BaseCount + (Layer < ExtraCount ? 1 : 0);
+		const float MinW = static_cast<float>(Start) / Count;
+		const float Depth = static_cast<float>(LayerCount) / Count;
+		ForEachStratum2D(LayerCount, [&](const int32 Index, const float MinU, const float MinV, const float Width, const float Height)
+		{
+			Visit(Start + Index, MinU, MinV, MinW, Width, Height, Depth);
+		});
+		Start += LayerCount;
+	}
+}
+
+/**
+ * Generates sphere points chunk by chunk into float SoA buffers and hands each chunk to a writer
+ * @param Engine - Engine providing the bulk raw draws
+ * @param Count - Number of points to generate
+ * @param Radius - Radius of the sphere
+ * @param bInside - Whether points fill the volume (cube root radius) or lie on the surface
+ * @param Write - Called with (Start, ChunkCount, X, Y, Z) for every chunk
+ */
+template <typename FWriter>
+static void GenerateSpherePoints(RandomEngine& Engine, const int32 Count, const float Radius, const bool bInside, FWriter&& Write)
+{
+	using namespace RandomKernels;
+
+	uint32 Raw[ChunkSize * 3];
+	float X[ChunkSize];
+	float Y[ChunkSize];
+	float Z[ChunkSize];
+
+	for (int32 Start = 0; Start < Count; Start += ChunkSize)
+	{
+		const int32 ChunkCount = FMath::Min(ChunkSize, Count - Start);
+		Engine.RandUInt32s(TArrayView<uint32>(Raw, ChunkCount * (bInside ? 3 : 2)));
+
+		// Same construction as RandPointOnSphere: uniform cos(polar), uniform azimuth
+		const uint32* RawCos = Raw;
+		const uint32* RawTurns = Raw + ChunkCount;
+		for (int32 i = 0; i < ChunkCount; ++i)
+		{
+			const float CosPolar = 2.0f * UnitFloat(RawCos[i]) - 1.0f;
+			const float SinPolar = FMath::Sqrt(FMath::Max(0.0f, 1.0f - CosPolar * CosPolar));
+			float SinAzimuth;
+			float CosAzimuth;
+			SinCosTurns(UnitFloat(RawTurns[i]), SinAzimuth, CosAzimuth);
+			X[i] = SinPolar * CosAzimuth * Radius;
+			Y[i] = SinPolar * SinAzimuth * Radius;
+			Z[i] = CosPolar * Radius;
+		}
+
+		if (bInside)
+		{
+			// Cube root of a uniform value gives a radius with uniform volume density
+			const uint32* RawRadius = Raw + ChunkCount * 2;
+			for (int32 i = 0; i < ChunkCount; ++i)
+			{
+				const float Scale = CubeRoot01(UnitFloat(RawRadius[i]));
+				X[i] *= Scale;
+				Y[i] *= Scale;
+				Z[i] *= Scale;
+			}
+		}
+
+		Write(Start, ChunkCount, X, Y, Z);
+	}
+}
+
+/**
+ * Generates sphere points into separate X/Y/Z arrays of any floating point type
+ */
+template <typename T>
+static void GenerateSpherePointsSoA(RandomEngine& Engine, TArrayView<T> OutX, TArrayView<T> OutY, TArrayView<T> OutZ, const float Radius, const bool bInside)
+{
+	if (OutX.Num() != OutY.Num() || OutX.Num() != OutZ.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::RandPoints%sSphere - X/Y/Z arrays have different sizes"), bInside ? TEXT("In") : TEXT("On"));
+	}
+	const int32 Count = FMath::Min3(OutX.Num(), OutY.Num(), OutZ.Num());
+	GenerateSpherePoints(Engine, Count, Radius, bInside, [&](const int32 Start, const int32 ChunkCount, const float* X, const float* Y, const float* Z)
+	{
+		for (int32 i = 0; i < ChunkCount; ++i)
+		{
+			OutX[Start + i] = X[i];
+			OutY[Start + i] = Y[i];
+			OutZ[Start + i] = Z[i];
+		}
+	});
+}
+
+/**
+ * Generates sphere points into an array of vectors
+ */
+static void GenerateSpherePointsAoS(RandomEngine& Engine, TArrayView<FVector> OutPoints, const float Radius, const bool bInside)
+{
+	GenerateSpherePoints(Engine, OutPoints.Num(), Radius, bInside, [&](const int32 Start, const int32 ChunkCount, const float* X, const float* Y, const float* Z)
+	{
+		for (int32 i = 0; i < ChunkCount; ++i)
+		{
+			OutPoints[Start + i] = FVector(X[i], Y[i], Z[i]);
+		}
+	});
+}
+
+
+RandomUtility::RandomUtility(): Engine(RandomEngine::StaticNewSeed())
+{
+}
+
+RandomUtility::RandomUtility(int32 InSeed): Engine(InSeed)
+{
+}
+
+RandomUtility::RandomUtility(int32 InSeed, ERandomEngineBackend InBackend): Engine(InSeed, InBackend)
+{
+}
+
+RandomUtility::~RandomUtility()
+{
+}
+
+int32 RandomUtility::GetSeed() const
+{
+	return Engine.GetRootSeed();
+}
+
+/**
+ * Fills colors from bulk raw draws, each 32-bit word holds the four uniform channel bytes
+ */
+static void FillRandomColors(RandomEngine& Engine, TArrayView<FColor> OutColors, const bool bRandomAlpha)
+{
+	uint32 Raw[RandomKernels::ChunkSize];
+	for (int32 Start = 0; Start < OutColors.Num(); Start += RandomKernels::ChunkSize)
+	{
+		const int32 Count = FMath::Min(RandomKernels::ChunkSize, OutColors.Num() - Start);
+		Engine.RandUInt32s(TArrayView<uint32>(Raw, Count));
+		for (int32 i = 0; i < Count; ++i)
+		{
+			FColor Color(Raw[i]);
+			if (!bRandomAlpha)
+			{
+				Color.A = 255;
+			}
+			OutColors[Start + i] = Color;
+		}
+	}
+}
+
+/** Golden ratio conjugate, hues stepped by it never repeat and stay evenly spread for any count */
+static constexpr double GoldenRatioConjugate = 0.6180339887498949;
+
+/** Bisection steps used to pull OKLab colors back into the sRGB gamut */
+static constexpr int32 PaletteGamutSteps = 12;
+
+static FORCEINLINE float SRGBToLinear(const float Value)
+{
+	return Value <= 0.04045f ? Value / 12.92f : FMath::Pow((Value + 0.055f) / 1.055f, 2.4f);
+}
+
+/** Converts linear sRGB to OKLab (Ottosson's matrices) */
+static FVector3f LinearToOKLab(const FLinearColor& Color)
+{
+	const float L = std::cbrt(0.4122214708f * Color.R + 0.5363325363f * Color.G + 0.0514459929f * Color.B);
+	const float M = std::cbrt(0.2119034982f * Color.R + 0.6806995451f * Color.G + 0.1073969566f * Color.B);
+	const float S = std::cbrt(0.0883024619f * Color.R + 0.2817188376f * Color.G + 0.6299787005f * Color.B);
+	return FVector3f(
+		0.2104542553f * L + 0.7936177850f * M - 0.0040720468f * S,
+		1.9779984951f * L - 2.4285922050f * M + 0.4505937099f * S,
+		0.0259040371f * L + 0.7827717662f * M - 0.8086757660f * S);
+}
+
+/** Converts OKLab to linear sRGB, the result can be outside [0, 1] */
+static FLinearColor OKLabToLinear(const FVector3f& Lab)
+{
+	const float L = FMath::Cube(Lab.X + 0.3963377774f * Lab.Y + 0.2158037573f * Lab.Z);
+	const float M = FMath::Cube(Lab.X - 0.1055613458f * Lab.Y - 0.0638541728f * Lab.Z);
+	const float S = FMath::Cube(Lab.X - 0.0894841775f * Lab.Y - 1.2914855480f * Lab.Z);
+	return FLinearColor(
+		4.0767416621f * L - 3.3077115913f * M + 0.2309699292f * S,
+		-1.2684380046f * L + 2.6097574011f * M - 0.3413193965f * S,
+		-0.0041960863f * L - 0.7034186147f * M + 1.7076147010f * S,
+		1.0f);
+}
+
+static FORCEINLINE bool IsInGamut(const FLinearColor& Color)
+{
+	return Color.R >= 0.0f && Color.R <= 1.0f && Color.G >= 0.0f && Color.G <= 1.0f && Color.B >= 0.0f && Color.B <= 1.0f;
+}
+
+/**
+ * Converts OKLab to linear sRGB, lowering the chroma until the color fits in the gamut
+ * Lightness and hue are kept, the gray of the same lightness always fits.
+ */
+static FLinearColor OKLabToLinearInGamut(const FVector3f& Lab)
+{
+	const FLinearColor Color = OKLabToLinear(Lab);
+	if (IsInGamut(Color))
+	{
+		return Color;
+	}
+	float Low = 0.0f;
+	float High = 1.0f;
+	for (int32 Step = 0; Step < PaletteGamutSteps; ++Step)
+	{
+		const float Mid = 0.5f * (Low + High);
+		if (IsInGamut(OKLabToLinear(FVector3f(Lab.X, Lab.Y * Mid, Lab.Z * Mid))))
+		{
+			Low = Mid;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+	return OKLabToLinear(FVector3f(Lab.X, Lab.Y * Low, Lab.Z * Low)).GetClamped();
+}
+
+/**
+ * Colors placed so far, bucketed in OKLab cells as wide as the minimum distance, so a
+ * candidate only looks at the colors of the 27 cells around it
+ */
+struct FPaletteGrid
+{
+	float CellSize;
+	float MinDistanceSq;
+	TMap<FIntVector, int32> Heads;
+	TArray<FVector3f> Labs;
+	TArray<int32> Next;
+
+	FPaletteGrid(const float MinDistance, const int32 Capacity):
+		CellSize(FMath::Max(MinDistance, KINDA_SMALL_NUMBER)), MinDistanceSq(MinDistance * MinDistance)
+	{
+		Heads.Reserve(Capacity);
+		Labs.Reserve(Capacity);
+		Next.Reserve(Capacity);
+	}
+
+	FIntVector CellOf(const FVector3f& Lab) const
+	{
+		return FIntVector(FMath::FloorToInt(Lab.X / CellSize), FMath::FloorToInt(Lab.Y / CellSize), FMath::FloorToInt(Lab.Z / CellSize));
+	}
+
+	/** Squared distance to the nearest placed color, capped at the squared minimum distance */
+	float NearestDistanceSq(const FVector3f& Lab) const
+	{
+		float Nearest = MinDistanceSq;
+		const FIntVector Cell = CellOf(Lab);
+		for (int32 Z = -1; Z <= 1; ++Z)
+		{
+			for (int32 Y = -1; Y <= 1; ++Y)
+			{
+				for (int32 X = -1; X <= 1; ++X)
+				{
+					const int32* Head = Heads.Find(Cell + FIntVector(X, Y, Z));
+					for (int32 Index = Head ? *Head : INDEX_NONE; Index != INDEX_NONE; Index = Next[Index])
+					{
+						Nearest = FMath::Min(Nearest, (Labs[Index] - Lab).SizeSquared());
+					}
+				}
+			}
+		}
+		return Nearest;
+	}
+
+	void Add(const FVector3f& Lab)
+	{
+		const int32 Index = Labs.Add(Lab);
+		int32& Head = Heads.FindOrAdd(CellOf(Lab), INDEX_NONE);
+		Next.Add(Head);
+		Head = Index;
+	}
+};
+
+/**
+ * Draws one palette candidate
+ * @param Settings - Palette settings
+ * @param Hue - Hue of GoldenHue palettes, in [0, 1)
+ * @param Next - Source of uniform floats in [0, 1)
+ * @return Linear color, inside the sRGB gamut
+ */
+template <typename FSource>
+static FLinearColor SamplePaletteColor(const RandomPaletteSettings& Settings, const float Hue, FSource&& Next)
+{
+	if (Settings.Mode == ERandomPaletteMode::OKLab)
+	{
+		const float Lightness = FMath::Clamp(FMath::Lerp(Settings.MinLightness, Settings.MaxLightness, Next()), 0.0f, 1.0f);
+		const float Chroma = FMath::Sqrt(FMath::Lerp(FMath::Square(Settings.MinChroma), FMath::Square(Settings.MaxChroma), Next()));
+		float Sin;
+		float Cos;
+		RandomKernels::SinCosTurns(Next(), Sin, Cos);
+		return OKLabToLinearInGamut(FVector3f(Lightness, Chroma * Cos, Chroma * Sin));
+	}
+
+	const float H = Settings.Mode == ERandomPaletteMode::GoldenHue ? Hue : Next();
+	const float Saturation = FMath::Clamp(FMath::Lerp(Settings.MinSaturation, Settings.MaxSaturation, Next()), 0.0f, 1.0f);
+	const float Value = FMath::Clamp(FMath::Lerp(Settings.MinValue, Settings.MaxValue, Next()), 0.0f, 1.0f);
+	const FLinearColor Encoded = FLinearColor(H * 360.0f, Saturation, Value).HSVToLinearRGB();
+	return FLinearColor(SRGBToLinear(Encoded.R), SRGBToLinear(Encoded.G), SRGBToLinear(Encoded.B), 1.0f);
+}
+
+/**
+ * Fills a palette, every color keeps the first candidate at least MinDistance from the colors
+ * before it, or the farthest candidate once the attempts run out
+ * @return True if every color met the minimum distance
+ */
+static bool GeneratePalette(RandomEngine& Engine, TArrayView<FLinearColor> OutColors, const RandomPaletteSettings& Settings)
+{
+	if (Settings.MinSaturation > Settings.MaxSaturation || Settings.MinValue > Settings.MaxValue || Settings.MinLightness > Settings.MaxLightness || Settings.MinChroma > Settings.MaxChroma)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::RandPalette - A Min setting is larger than its Max"));
+	}
+
+	RandomKernels::FUniformStream Stream(Engine);
+	auto Next = [&Stream]() { return Stream.Next(); };
+
+	const bool bCheckDistance = Settings.MinDistance > 0.0f;
+	const int32 Attempts = bCheckDistance ? FMath::Max(Settings.MaxAttempts, 1) : 1;
+	FPaletteGrid Grid(FMath::Max(Settings.MinDistance, 0.0f), bCheckDistance ? OutColors.Num() : 0);
+	const double StartHue = Stream.Next();
+
+	bool bAllDistinct = true;
+	for (int32 i = 0; i < OutColors.Num(); ++i)
+	{
+		const float Hue = static_cast<float>(FMath::Frac(StartHue + i * GoldenRatioConjugate));
+		FLinearColor Best;
+		FVector3f BestLab;
+		float BestDistanceSq = -1.0f;
+		for (int32 Attempt = 0; Attempt < Attempts; ++Attempt)
+		{
+			const FLinearColor Color = SamplePaletteColor(Settings, Hue, Next);
+			const FVector3f Lab = bCheckDistance ? LinearToOKLab(Color) : FVector3f::ZeroVector;
+			const float DistanceSq = bCheckDistance ? Grid.NearestDistanceSq(Lab) : 0.0f;
+			if (DistanceSq > BestDistanceSq)
+			{
+				Best = Color;
+				BestLab = Lab;
+				BestDistanceSq = DistanceSq;
+			}
+			if (DistanceSq >= Grid.MinDistanceSq)
+			{
+				break;
+			}
+		}
+
+		if (bCheckDistance)
+		{
+			bAllDistinct &= BestDistanceSq >= Grid.MinDistanceSq;
+			Grid.Add(BestLab);
+		}
+		OutColors[i] = Best;
+	}
+	return bAllDistinct;
+}
+
+FColor RandomUtility::RandColor()
+{
+	// One 32-bit draw holds four uniform bytes, alpha is forced opaque
+	FColor Color(Engine.RandUInt32());
+	Color.A = 255;
+	return Color;
+}
+
+FColor RandomUtility::RandColorAlpha()
+{
+	// One 32-bit draw holds four uniform bytes (RGBA)
+	return FColor(Engine.RandUInt32());
+}
+
+void RandomUtility::RandColors(TArrayView<FColor> OutColors, const bool bRandomAlpha)
+{
+	FillRandomColors(Engine, OutColors, bRandomAlpha);
+}
+
+void RandomUtility::RandColorsParallel(TArrayView<FColor> OutColors, const bool bRandomAlpha)
+{
+	RandomKernels::ParallelForDeterministic(Engine, OutColors.Num(), RandomKernels::ParallelBlockSize,
+		[OutColors, bRandomAlpha](RandomEngine& BlockEngine, const int32 Start, const int32 Count)
+		{
+			FillRandomColors(BlockEngine, OutColors.Slice(Start, Count), bRandomAlpha);
+		});
+}
+
+bool RandomUtility::RandPalette(TArrayView<FLinearColor> OutColors, const RandomPaletteSettings& Settings)
+{
+	return GeneratePalette(Engine, OutColors, Settings);
+}
+
+bool RandomUtility::RandPalette(TArrayView<FColor> OutColors, const RandomPaletteSettings& Settings)
+{
+	TArray<FLinearColor> Colors;
+	Colors.SetNumUninitialized(OutColors.Num());
+	const bool bAllDistinct = GeneratePalette(Engine, Colors, Settings);
+	for (int32 i = 0; i < Colors.Num(); ++i)
+	{
+		OutColors[i] = Colors[i].ToFColor(true);
+	}
+	return bAllDistinct;
+}
+
+FVector RandomUtility::RandVector(const float Min, const float Max)
+{
+	// Generate random X, Y, Z components within the specified range
+	const float X = Engine.RandFloat(Min, Max);
+	const float Y = Engine.RandFloat(Min, Max);
+	const float Z = Engine.RandFloat(Min, Max);
+
+	return FVector(X, Y, Z);
+}
+
+FVector RandomUtility::RandVectorNormalized()
+{
+	// Generate a random vector and normalize it to unit length
+	// Using spherical coordinates to ensure uniform distribution on unit sphere
+	const float Theta = Engine.RandFloat(0.0f, 2.0f * PI); // Azimuth angle (0 to 2π)
+	const float CosPhiPolar = Engine.RandFloat(-1.0f, 1.0f); // Cosine of polar angle (-1 to 1)
+
+	// Use sqrt(1 - cos²(φ)) instead of sin(acos(cos(φ))) for better numerical stability
+	const float SinPhiPolar = FMath::Sqrt(1.0f - CosPhiPolar * CosPhiPolar);
+
+	const float X = SinPhiPolar * FMath::Cos(Theta);
+	const float Y = SinPhiPolar * FMath::Sin(Theta);
+	const float Z = CosPhiPolar;
+
+	return FVector(X, Y, Z);
+}
+
+FVector2D RandomUtility::RandVector2D(const float Min, const float Max)
+{
+	// Generate random X, Y components within the specified range
+	const float X = Engine.RandFloat(Min, Max);
+	const float Y = Engine.RandFloat(Min, Max);
+
+	return FVector2D(X, Y);
+}
+
+FVector2D RandomUtility::RandVector2DNormalized()
+{
+	// Generate a random unit vector (length = 1.0) on the unit circle
+	const float Angle = Engine.RandFloat(0.0f, 2.0f * PI);
+
+	const float X = FMath::Cos(Angle);
+	const float Y = FMath::Sin(Angle);
+
+	return FVector2D(X, Y);
+}
+
+FVector2D RandomUtility::RandVector2DInCircle(const float Radius)
+{
+	// Generate a random point inside a circle using rejection sampling for uniform distribution
+	const float Angle = Engine.RandFloat(0.0f, 2.0f * PI);
+	const float R = FMath::Sqrt(Engine.RandFloat(0.0f, 1.0f)) * Radius;
+
+	const float X = R * FMath::Cos(Angle);
+	const float Y = R * FMath::Sin(Angle);
+
+	return FVector2D(X, Y);
+}
+
+FVector2D RandomUtility::RandVector2DOnCircle(const float Radius)
+{
+	// Generate a random point on the circumference of a circle
+	const float Angle = Engine.RandFloat(0.0f, 2.0f * PI);
+
+	const float X = FMath::Cos(Angle);
+	const float Y = FMath::Sin(Angle);
+
+	return FVector2D(X, Y) * Radius;
+}
+
+FVector RandomUtility::RandPointInSphere(const float Radius)
+{
+	// Generate a random point inside a sphere using spherical coordinates
+	const float Theta = Engine.RandFloat(0.0f, 2.0f * PI); // Azimuth angle
+	const float CosPhiPolar = Engine.RandFloat(-1.0f, 1.0f); // Cosine of polar angle
+	const float R = FMath::Pow(Engine.RandFloat(0.0f, 1.0f), 1.0f / 3.0f); // Cube root for uniform distribution
+
+	// Use sqrt(1 - cos²(φ)) instead of sin(acos(cos(φ))) for better numerical stability
+	const float SinPhiPolar = FMath::Sqrt(1.0f - CosPhiPolar * CosPhiPolar);
+
+	// Generate unit vector, then scale by random radius
+	const FVector UnitVector(
+		SinPhiPolar * FMath::Cos(Theta),
+		SinPhiPolar * FMath::Sin(Theta),
+		CosPhiPolar
+	);
+
+	return UnitVector * (R * Radius);
+}
+
+FVector RandomUtility::RandPointOnSphere(const float Radius)
+{
+	// Generate a random point on the surface of a sphere
+	const float Theta = Engine.RandFloat(0.0f, 2.0f * PI); // Azimuth angle
+	const float CosPhiPolar = Engine.RandFloat(-1.0f, 1.0f); // Cosine of polar angle
+
+	// Use sqrt(1 - cos²(φ)) instead of sin(acos(cos(φ))) for better numerical stability
+	const float SinPhiPolar = FMath::Sqrt(1.0f - CosPhiPolar * CosPhiPolar);
+
+	// Generate unit vector, then scale by radius
+	const FVector UnitVector(
+		SinPhiPolar * FMath::Cos(Theta),
+		SinPhiPolar * FMath::Sin(Theta),
+		CosPhiPolar
+	);
+
+	return UnitVector * Radius;
+}
+
+void RandomUtility::RandPointsInSphere(TArrayView<float> OutX, TArrayView<float> OutY, TArrayView<float> OutZ, const float Radius)
+{
+	GenerateSpherePointsSoA(Engine, OutX, OutY, OutZ, Radius, true);
+}
+
+void RandomUtility::RandPointsInSphere(TArrayView<double> OutX, TArrayView<double> OutY, TArrayView<double> OutZ, const float Radius)
+{
+	GenerateSpherePointsSoA(Engine, OutX, OutY, OutZ, Radius, true);
+}
+
+void RandomUtility::RandPointsInSphere(TArrayView<FVector> OutPoints, const float Radius)
+{
+	GenerateSpherePointsAoS(Engine, OutPoints, Radius, true);
+}
+
+void RandomUtility::RandPointsOnSphere(TArrayView<float> OutX, TArrayView<float> OutY, TArrayView<float> OutZ, const float Radius)
+{
+	GenerateSpherePointsSoA(Engine, OutX, OutY, OutZ, Radius, false);
+}
+
+void RandomUtility::RandPointsOnSphere(TArrayView<double> OutX, TArrayView<double> OutY, TArrayView<double> OutZ, const float Radius)
+{
+	GenerateSpherePointsSoA(Engine, OutX, OutY, OutZ, Radius, false);
+}
+
+void RandomUtility::RandPointsOnSphere(TArrayView<FVector> OutPoints, const float Radius)
+{
+	GenerateSpherePointsAoS(Engine, OutPoints, Radius, false);
+}
+
+FVector RandomUtility::RandPointInCircle(const float Radius)
+{
+	// Generate a random point inside a circle in the XY plane (Z = 0)
+	const FVector2D Point2D = RandVector2DInCircle(Radius);
+	return FVector(Point2D.X, Point2D.Y, 0.0f);
+}
+
+FVector RandomUtility::RandPointOnCircle(const float Radius)
+{
+	// Generate a random point on the circumference of a circle in the XY plane (Z = 0)
+	const FVector2D Point2D = RandVector2DOnCircle(Radius);
+	return FVector(Point2D.X, Point2D.Y, 0.0f);
+}
+
+FQuat RandomUtility::RandQuat()
+{
+	// Generate a random quaternion using Shoemake's method for uniform distribution
+	const float U1 = Engine.RandFloat(0.0f, 1.0f);
+	const float U2 = Engine.RandFloat(0.0f, 2.0f * PI);
+	const float U3 = Engine.RandFloat(0.0f, 2.0f * PI);
+
+	const float SqrtU1 = FMath::Sqrt(U1);
+	const float Sqrt1MinusU1 = FMath::Sqrt(1.0f - U1);
+
+	const float X = Sqrt1MinusU1 * FMath::Sin(U2);
+	const float Y = Sqrt1MinusU1 * FMath::Cos(U2);
+	const float Z = SqrtU1 * FMath::Sin(U3);
+	const float W = SqrtU1 * FMath::Cos(U3);
+
+	return FQuat(X, Y, Z, W);
+}
+
+FVector RandomUtility::RandVectorNormalizedRejection()
+{
+	return SampleUnitSphereMarsaglia([this]() { return Engine.RandFloat(-1.0f, 1.0f); });
+}
+
+FVector2D RandomUtility::RandVector2DNormalizedRejection()
+{
+	return SampleUnitCirclePolar([this]() { return Engine.RandFloat(-1.0f, 1.0f); });
+}
+
+FQuat RandomUtility::RandQuatRejection()
+{
+	return SampleUnitQuatMarsaglia([this]() { return Engine.RandFloat(-1.0f, 1.0f); });
+}
+
+void RandomUtility::RandVectorsNormalized(TArrayView<FVector> OutVectors)
+{
+	RandomKernels::FUniformStream Stream(Engine);
+	for (FVector& Vector : OutVectors)
+	{
+		Vector = SampleUnitSphereMarsaglia([&Stream]() { return Stream.NextSigned(); });
+	}
+}
+
+void RandomUtility::RandVectors2DNormalized(TArrayView<FVector2D> OutVectors)
+{
+	RandomKernels::FUniformStream Stream(Engine);
+	for (FVector2D& Vector : OutVectors)
+	{
+		Vector = SampleUnitCirclePolar([&Stream]() { return Stream.NextSigned(); });
+	}
+}
+
+void RandomUtility::RandQuats(TArrayView<FQuat> OutQuats)
+{
+	RandomKernels::FUniformStream Stream(Engine);
+	for (FQuat& Quat : OutQuats)
+	{
+		Quat = SampleUnitQuatMarsaglia([&Stream]() { return Stream.NextSigned(); });
+	}
+}
+
+FVector RandomUtility::RandHemisphereDirection(const FVector& Normal, const ERandomHemisphereLobe Lobe, const float Shape)
+{
+	const float U = Engine.RandFloat();
+	const float V = Engine.RandFloat();
+	const FHemisphereFrame Frame(Normal);
+	FVector Direction;
+	DispatchHemisphereLobe(Lobe, Shape, [&](auto&& Map)
+	{
+		float X;
+		float Y;
+		float Z;
+		Map(U, V, X, Y, Z);
+		Direction = Frame.ToWorld(X, Y, Z);
+	});
+	return Direction;
+}
 
-RandomUtility::RandomUtility(): Engine(RandomEngine::StaticNewSeed())
+void RandomUtility::RandHemisphereDirections(TArrayView<FVector> OutDirections, const FVector& Normal, const ERandomHemisphereLobe Lobe, const float Shape)
 {
+	GenerateHemisphereDirections(Engine, OutDirections.Num(), Normal, Lobe, Shape, [&](const int32 Start, const int32 ChunkCount, const float* X, const float* Y, const float* Z)
+	{
+		for (int32 i = 0; i < ChunkCount; ++i)
+		{
+			OutDirections[Start + i] = FVector(X[i], Y[i], Z[i]);
+		}
+	});
 }
 
-RandomUtility::RandomUtility(int32 InSeed): Engine(InSeed)
+void RandomUtility::RandHemisphereDirections(TArrayView<float> OutX, TArrayView<float> OutY, TArrayView<float> OutZ, const FVector& Normal, const ERandomHemisphereLobe Lobe, const float Shape)
 {
+	if (OutX.Num() != OutY.Num() || OutX.Num() != OutZ.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::RandHemisphereDirections - X/Y/Z arrays have different sizes"));
+	}
+	const int32 Count = FMath::Min3(OutX.Num(), OutY.Num(), OutZ.Num());
+	GenerateHemisphereDirections(Engine, Count, Normal, Lobe, Shape, [&](const int32 Start, const int32 ChunkCount, const float* X, const float* Y, const float* Z)
+	{
+		FMemory::Memcpy(&OutX[Start], X, ChunkCount * sizeof(float));
+		FMemory::Memcpy(&OutY[Start], Y, ChunkCount * sizeof(float));
+		FMemory::Memcpy(&OutZ[Start], Z, ChunkCount * sizeof(float));
+	});
 }
 
-RandomUtility::~RandomUtility()
+FVector RandomUtility::QuasiHemisphereDirection(const RandomQuasiSequence& Sequence, const uint32 Index, const FVector& Normal, const ERandomHemisphereLobe Lobe, const float Shape)
 {
+	FVector Direction;
+	QuasiHemisphereDirections(TArrayView<FVector>(&Direction, 1), Sequence, Index, Normal, Lobe, Shape);
+	return Direction;
 }
 
-int32 RandomUtility::GetSeed() const
+void RandomUtility::QuasiHemisphereDirections(TArrayView<FVector> OutDirections, const RandomQuasiSequence& Sequence, const uint32 StartIndex, const FVector& Normal, const ERandomHemisphereLobe Lobe, const float Shape)
 {
-	return Engine.GetRootSeed();
+	const FHemisphereFrame Frame(Normal);
+	DispatchHemisphereLobe(Lobe, Shape, [&](auto&& Map)
+	{
+		for (int32 i = 0; i < OutDirections.Num(); ++i)
+		{
+			const FVector2D Unit = Sequence.GetPoint2D(StartIndex + static_cast<uint32>(i));
+			float X;
+			float Y;
+			float Z;
+			Map(static_cast<float>(Unit.X), static_cast<float>(Unit.Y), X, Y, Z);
+			OutDirections[i] = Frame.ToWorld(X, Y, Z);
+		}
+	});
 }
 
-FColor RandomUtility::RandColor()
+float RandomUtility::HemisphereDirectionPdf(const FVector& Normal, const FVector& Direction, const ERandomHemisphereLobe Lobe, const float Shape)
 {
-	// Generate random RGBA components (0-255)
-	const uint8 R = static_cast<uint8>(Engine.RandInt(0, 255));
-	const uint8 G = static_cast<uint8>(Engine.RandInt(0, 255));
-	const uint8 B = static_cast<uint8>(Engine.RandInt(0, 255));
+	const float CosPolar = FVector::DotProduct(Normal.GetSafeNormal(SMALL_NUMBER, FVector::UpVector), Direction);
+	if (CosPolar <= 0.0f)
+	{
+		return 0.0f;
+	}
 
-	return FColor(R, G, B);
+	switch (Lobe)
+	{
+	case ERandomHemisphereLobe::Uniform:
+		return 1.0f / (2.0f * PI);
+	case ERandomHemisphereLobe::Phong:
+		{
+			const float Exponent = FMath::Max(Shape, 0.0f);
+			return (Exponent + 1.0f) / (2.0f * PI) * FMath::Pow(CosPolar, Exponent);
+		}
+	case ERandomHemisphereLobe::GGX:
+		{
+			// D(h) * cos(h) with D(h) = Alpha^2 / (PI * ((Alpha^2 - 1) * cos^2 + 1)^2)
+			const float AlphaSq = FMath::Square(FMath::Max(Shape, MinGGXAlpha));
+			const float Denominator = (AlphaSq - 1.0f) * CosPolar * CosPolar + 1.0f;
+			return AlphaSq * CosPolar / (PI * Denominator * Denominator);
+		}
+	default:
+		return CosPolar / PI;
+	}
 }
 
-FColor RandomUtility::RandColorAlpha()
+FVector RandomUtility::RandPointInBox(const FBox& Box)
 {
-	// Generate random RGBA components (0-255)
-	const uint8 R = static_cast<uint8>(Engine.RandInt(0, 255));
-	const uint8 G = static_cast<uint8>(Engine.RandInt(0, 255));
-	const uint8 B = static_cast<uint8>(Engine.RandInt(0, 255));
-	const uint8 A = static_cast<uint8>(Engine.RandInt(0, 255));
+	return Box.GetCenter() + SampleBoxLocal(Box.GetExtent(), false, [this]() { return Engine.RandFloat(); });
+}
 
-	return FColor(R, G, B, A);
+void RandomUtility::RandPointsInBox(TArrayView<FVector> OutPoints, const FBox& Box)
+{
+	const FVector Center = Box.GetCenter();
+	const FVector Extent = Box.GetExtent();
+	FillFromStream(Engine, OutPoints, [&](auto& Next) { return Center + SampleBoxLocal(Extent, false, Next); });
 }
 
-FVector RandomUtility::RandVector(const float Min, const float Max)
+FVector RandomUtility::RandPointOnBox(const FBox& Box)
 {
-	// Generate random X, Y, Z components within the specified range
-	const float X = Engine.RandFloat(Min, Max);
-	const float Y = Engine.RandFloat(Min, Max);
-	const float Z = Engine.RandFloat(Min, Max);
+	return Box.GetCenter() + SampleBoxLocal(Box.GetExtent(), true, [this]() { return Engine.RandFloat(); });
+}
 
-	return FVector(X, Y, Z);
+void RandomUtility::RandPointsOnBox(TArrayView<FVector> OutPoints, const FBox& Box)
+{
+	const FVector Center = Box.GetCenter();
+	const FVector Extent = Box.GetExtent();
+	FillFromStream(Engine, OutPoints, [&](auto& Next) { return Center + SampleBoxLocal(Extent, true, Next); });
 }
 
-FVector RandomUtility::RandVectorNormalized()
+/** Maps a point from the local frame of an oriented box to world space */
+static FORCEINLINE FVector OrientedBoxToWorld(const FOrientedBox& Box, const FVector& Local)
 {
-	// Generate a random vector and normalize it to unit length
-	// Using spherical coordinates to ensure uniform distribution on unit sphere
-	const float Theta = Engine.RandFloat(0.0f, 2.0f * PI); // Azimuth angle (0 to 2π)
-	const float CosPhiPolar = Engine.RandFloat(-1.0f, 1.0f); // Cosine of polar angle (-1 to 1)
+	return Box.Center + Box.AxisX * Local.X + Box.AxisY * Local.Y + Box.AxisZ * Local.Z;
+}
 
-	// Use sqrt(1 - cos²(φ)) instead of sin(acos(cos(φ))) for better numerical stability
-	const float SinPhiPolar = FMath::Sqrt(1.0f - CosPhiPolar * CosPhiPolar);
+FVector RandomUtility::RandPointInOrientedBox(const FOrientedBox& Box)
+{
+	const FVector Extent(Box.ExtentX, Box.ExtentY, Box.ExtentZ);
+	return OrientedBoxToWorld(Box, SampleBoxLocal(Extent, false, [this]() { return Engine.RandFloat(); }));
+}
 
-	const float X = SinPhiPolar * FMath::Cos(Theta);
-	const float Y = SinPhiPolar * FMath::Sin(Theta);
-	const float Z = CosPhiPolar;
+void RandomUtility::RandPointsInOrientedBox(TArrayView<FVector> OutPoints, const FOrientedBox& Box)
+{
+	const FVector Extent(Box.ExtentX, Box.ExtentY, Box.ExtentZ);
+	FillFromStream(Engine, OutPoints, [&](auto& Next) { return OrientedBoxToWorld(Box, SampleBoxLocal(Extent, false, Next)); });
+}
 
-	return FVector(X, Y, Z);
+FVector RandomUtility::RandPointOnOrientedBox(const FOrientedBox& Box)
+{
+	const FVector Extent(Box.ExtentX, Box.ExtentY, Box.ExtentZ);
+	return OrientedBoxToWorld(Box, SampleBoxLocal(Extent, true, [this]() { return Engine.RandFloat(); }));
 }
 
-FVector2D RandomUtility::RandVector2D(const float Min, const float Max)
+void RandomUtility::RandPointsOnOrientedBox(TArrayView<FVector> OutPoints, const FOrientedBox& Box)
 {
-	// Generate random X, Y components within the specified range
-	const float X = Engine.RandFloat(Min, Max);
-	const float Y = Engine.RandFloat(Min, Max);
+	const FVector Extent(Box.ExtentX, Box.ExtentY, Box.ExtentZ);
+	FillFromStream(Engine, OutPoints, [&](auto& Next) { return OrientedBoxToWorld(Box, SampleBoxLocal(Extent, true, Next)); });
+}
 
-	return FVector2D(X, Y);
+FVector RandomUtility::RandPointInCapsule(const FVector& Start, const FVector& End, const float Radius)
+{
+	return SampleCapsule(Start, End, Radius, false, [this]() { return Engine.RandFloat(); });
 }
 
-FVector2D RandomUtility::RandVector2DNormalized()
+void RandomUtility::RandPointsInCapsule(TArrayView<FVector> OutPoints, const FVector& Start, const FVector& End, const float Radius)
 {
-	// Generate a random unit vector (length = 1.0) on the unit circle
-	const float Angle = Engine.RandFloat(0.0f, 2.0f * PI);
+	FillFromStream(Engine, OutPoints, [&](auto& Next) { return SampleCapsule(Start, End, Radius, false, Next); });
+}
 
-	const float X = FMath::Cos(Angle);
-	const float Y = FMath::Sin(Angle);
+FVector RandomUtility::RandPointOnCapsule(const FVector& Start, const FVector& End, const float Radius)
+{
+	return SampleCapsule(Start, End, Radius, true, [this]() { return Engine.RandFloat(); });
+}
 
-	return FVector2D(X, Y);
+void RandomUtility::RandPointsOnCapsule(TArrayView<FVector> OutPoints, const FVector& Start, const FVector& End, const float Radius)
+{
+	FillFromStream(Engine, OutPoints, [&](auto& Next) { return SampleCapsule(Start, End, Radius, true, Next); });
 }
 
-FVector2D RandomUtility::RandVector2DInCircle(const float Radius)
+FVector RandomUtility::RandPointInCone(const FVector& Apex, const FVector& Direction, const float Height, const float BaseRadius)
 {
-	// Generate a random point inside a circle using rejection sampling for uniform distribution
-	const float Angle = Engine.RandFloat(0.0f, 2.0f * PI);
-	const float R = FMath::Sqrt(Engine.RandFloat(0.0f, 1.0f)) * Radius;
+	return SampleCone(Apex, Direction, Height, BaseRadius, false, [this]() { return Engine.RandFloat(); });
+}
 
-	const float X = R * FMath::Cos(Angle);
-	const float Y = R * FMath::Sin(Angle);
+void RandomUtility::RandPointsInCone(TArrayView<FVector> OutPoints, const FVector& Apex, const FVector& Direction, const float Height, const float BaseRadius)
+{
+	FillFromStream(Engine, OutPoints, [&](auto& Next) { return SampleCone(Apex, Direction, Height, BaseRadius, false, Next); });
+}
 
-	return FVector2D(X, Y);
+FVector RandomUtility::RandPointOnCone(const FVector& Apex, const FVector& Direction, const float Height, const float BaseRadius)
+{
+	return SampleCone(Apex, Direction, Height, BaseRadius, true, [this]() { return Engine.RandFloat(); });
 }
 
-FVector2D RandomUtility::RandVector2DOnCircle(const float Radius)
+void RandomUtility::RandPointsOnCone(TArrayView<FVector> OutPoints, const FVector& Apex, const FVector& Direction, const float Height, const float BaseRadius)
 {
-	// Generate a random point on the circumference of a circle
-	const float Angle = Engine.RandFloat(0.0f, 2.0f * PI);
+	FillFromStream(Engine, OutPoints, [&](auto& Next) { return SampleCone(Apex, Direction, Height, BaseRadius, true, Next); });
+}
 
-	const float X = FMath::Cos(Angle);
-	const float Y = FMath::Sin(Angle);
+FVector2D RandomUtility::RandPointInAnnulus(const float InnerRadius, const float OuterRadius)
+{
+	if (InnerRadius > OuterRadius)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::RandPointInAnnulus - InnerRadius is larger than OuterRadius"));
+	}
+	return SampleAnnulus(InnerRadius, OuterRadius, [this]() { return Engine.RandFloat(); });
+}
 
-	return FVector2D(X, Y) * Radius;
+void RandomUtility::RandPointsInAnnulus(TArrayView<FVector2D> OutPoints, const float InnerRadius, const float OuterRadius)
+{
+	if (InnerRadius > OuterRadius)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::RandPointsInAnnulus - InnerRadius is larger than OuterRadius"));
+	}
+	FillFromStream(Engine, OutPoints, [&](auto& Next) { return SampleAnnulus(InnerRadius, OuterRadius, Next); });
 }
 
-FVector RandomUtility::RandPointInSphere(const float Radius)
+FVector RandomUtility::RandPointOnSphericalCap(const FVector& Direction, const float HalfAngleDegrees, const float Radius)
 {
-	// Generate a random point inside a sphere using spherical coordinates
-	const float Theta = Engine.RandFloat(0.0f, 2.0f * PI); // Azimuth angle
-	const float CosPhiPolar = Engine.RandFloat(-1.0f, 1.0f); // Cosine of polar angle
-	const float R = FMath::Pow(Engine.RandFloat(0.0f, 1.0f), 1.0f / 3.0f); // Cube root for uniform distribution
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.0f, 180.0f)));
+	return SampleSphericalCap(Direction, CosHalfAngle, [this]() { return Engine.RandFloat(); }) * Radius;
+}
 
-	// Use sqrt(1 - cos²(φ)) instead of sin(acos(cos(φ))) for better numerical stability
-	const float SinPhiPolar = FMath::Sqrt(1.0f - CosPhiPolar * CosPhiPolar);
+void RandomUtility::RandPointsOnSphericalCap(TArrayView<FVector> OutPoints, const FVector& Direction, const float HalfAngleDegrees, const float Radius)
+{
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.0f, 180.0f)));
+	FillFromStream(Engine, OutPoints, [&](auto& Next) { return SampleSphericalCap(Direction, CosHalfAngle, Next) * Radius; });
+}
 
-	// Generate unit vector, then scale by random radius
-	const FVector UnitVector(
-		SinPhiPolar * FMath::Cos(Theta),
-		SinPhiPolar * FMath::Sin(Theta),
-		CosPhiPolar
-	);
+FVector RandomUtility::RandPointInSphericalSector(const FVector& Direction, const float HalfAngleDegrees, const float Radius)
+{
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.0f, 180.0f)));
+	const FVector Unit = SampleSphericalCap(Direction, CosHalfAngle, [this]() { return Engine.RandFloat(); });
+	return Unit * (Radius * RandomKernels::CubeRoot01(Engine.RandFloat()));
+}
 
-	return UnitVector * (R * Radius);
+void RandomUtility::RandPointsInSphericalSector(TArrayView<FVector> OutPoints, const FVector& Direction, const float HalfAngleDegrees, const float Radius)
+{
+	const float CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.0f, 180.0f)));
+	FillFromStream(Engine, OutPoints, [&](auto& Next)
+	{
+		const FVector Unit = SampleSphericalCap(Direction, CosHalfAngle, Next);
+		return Unit * (Radius * RandomKernels::CubeRoot01(Next()));
+	});
 }
 
-FVector RandomUtility::RandPointOnSphere(const float Radius)
+TArray<FVector2D> RandomUtility::RandPoissonDiskInRect(const FBox2D& Bounds, const float MinDistance, const int32 MaxAttempts, const bool bTiled)
 {
-	// Generate a random point on the surface of a sphere
-	const float Theta = Engine.RandFloat(0.0f, 2.0f * PI); // Azimuth angle
-	const float CosPhiPolar = Engine.RandFloat(-1.0f, 1.0f); // Cosine of polar angle
+	TArray<FVector2D> Points;
+	const FVector2D Size = Bounds.GetSize();
+	const float Extent[2] = {static_cast<float>(Size.X), static_cast<float>(Size.Y)};
+	auto IsInside = [](const float (&)[2]) { return true; };
+	GeneratePoissonDisk<2>(Engine, Extent, MinDistance, MaxAttempts, bTiled, IsInside, [&](const float (&Point)[2])
+	{
+		Points.Add(Bounds.Min + FVector2D(Point[0], Point[1]));
+	}, TEXT("RandPoissonDiskInRect"));
+	return Points;
+}
 
-	// Use sqrt(1 - cos²(φ)) instead of sin(acos(cos(φ))) for better numerical stability
-	const float SinPhiPolar = FMath::Sqrt(1.0f - CosPhiPolar * CosPhiPolar);
+TArray<FVector2D> RandomUtility::RandPoissonDiskInCircle(const FVector2D& Center, const float Radius, const float MinDistance, const int32 MaxAttempts, const bool bTiled)
+{
+	TArray<FVector2D> Points;
+	const float Extent[2] = {2.0f * Radius, 2.0f * Radius};
+	const float RadiusSq = Radius * Radius;
+	auto IsInside = [Radius, RadiusSq](const float (&Point)[2])
+	{
+		return FMath::Square(Point[0] - Radius) + FMath::Square(Point[1] - Radius) <= RadiusSq;
+	};
+	GeneratePoissonDisk<2>(Engine, Extent, MinDistance, MaxAttempts, bTiled, IsInside, [&](const float (&Point)[2])
+	{
+		Points.Add(Center + FVector2D(Point[0] - Radius, Point[1] - Radius));
+	}, TEXT("RandPoissonDiskInCircle"));
+	return Points;
+}
 
-	// Generate unit vector, then scale by radius
-	const FVector UnitVector(
-		SinPhiPolar * FMath::Cos(Theta),
-		SinPhiPolar * FMath::Sin(Theta),
-		CosPhiPolar
-	);
+TArray<FVector> RandomUtility::RandPoissonDiskInBox(const FBox& Bounds, const float MinDistance, const int32 MaxAttempts, const bool bTiled)
+{
+	TArray<FVector> Points;
+	const FVector Size = Bounds.GetSize();
+	const float Extent[3] = {static_cast<float>(Size.X), static_cast<float>(Size.Y), static_cast<float>(Size.Z)};
+	auto IsInside = [](const float (&)[3]) { return true; };
+	GeneratePoissonDisk<3>(Engine, Extent, MinDistance, MaxAttempts, bTiled, IsInside, [&](const float (&Point)[3])
+	{
+		Points.Add(Bounds.Min + FVector(Point[0], Point[1], Point[2]));
+	}, TEXT("RandPoissonDiskInBox"));
+	return Points;
+}
 
-	return UnitVector * Radius;
+TArray<FVector> RandomUtility::RandPoissonDiskInSphere(const FVector& Center, const float Radius, const float MinDistance, const int32 MaxAttempts, const bool bTiled)
+{
+	TArray<FVector> Points;
+	const float Extent[3] = {2.0f * Radius, 2.0f * Radius, 2.0f * Radius};
+	const float RadiusSq = Radius * Radius;
+	auto IsInside = [Radius, RadiusSq](const float (&Point)[3])
+	{
+		return FMath::Square(Point[0] - Radius) + FMath::Square(Point[1] - Radius) + FMath::Square(Point[2] - Radius) <= RadiusSq;
+	};
+	GeneratePoissonDisk<3>(Engine, Extent, MinDistance, MaxAttempts, bTiled, IsInside, [&](const float (&Point)[3])
+	{
+		Points.Add(Center + FVector(Point[0] - Radius, Point[1] - Radius, Point[2] - Radius));
+	}, TEXT("RandPoissonDiskInSphere"));
+	return Points;
 }
 
-FVector RandomUtility::RandPointInCircle(const float Radius)
+void RandomUtility::RandStratifiedInRect(TArrayView<FVector2D> OutPoints, const FBox2D& Bounds)
 {
-	// Generate a random point inside a circle in the XY plane (Z = 0)
-	const FVector2D Point2D = RandVector2DInCircle(Radius);
-	return FVector(Point2D.X, Point2D.Y, 0.0f);
+	RandomKernels::FUniformStream Stream(Engine);
+	const FVector2D Size = Bounds.GetSize();
+	ForEachStratum2D(OutPoints.Num(), [&](const int32 Index, const float MinU, const float MinV, const float Width, const float Height)
+	{
+		const float U = MinU + Width * Stream.Next();
+		const float V = MinV + Height * Stream.Next();
+		OutPoints[Index] = Bounds.Min + FVector2D(U, V) * Size;
+	});
 }
 
-FVector RandomUtility::RandPointOnCircle(const float Radius)
+void RandomUtility::RandStratifiedInCircle(TArrayView<FVector2D> OutPoints, const float Radius)
 {
-	// Generate a random point on the circumference of a circle in the XY plane (Z = 0)
-	const FVector2D Point2D = RandVector2DOnCircle(Radius);
-	return FVector(Point2D.X, Point2D.Y, 0.0f);
+	RandomKernels::FUniformStream Stream(Engine);
+	ForEachStratum2D(OutPoints.Num(), [&](const int32 Index, const float MinU, const float MinV, const float Width, const float Height)
+	{
+		float X;
+		float Y;
+		RandomKernels::SquareToDisk(MinU + Width * Stream.Next(), MinV + Height * Stream.Next(), X, Y);
+		OutPoints[Index] = FVector2D(X, Y) * Radius;
+	});
 }
 
-FQuat RandomUtility::RandQuat()
+void RandomUtility::RandStratifiedInSphere(TArrayView<FVector> OutPoints, const float Radius)
 {
-	// Generate a random quaternion using Shoemake's method for uniform distribution
-	const float U1 = Engine.RandFloat(0.0f, 1.0f);
-	const float U2 = Engine.RandFloat(0.0f, 2.0f * PI);
-	const float U3 = Engine.RandFloat(0.0f, 2.0f * PI);
+	RandomKernels::FUniformStream Stream(Engine);
+	ForEachStratum3D(OutPoints.Num(), [&](const int32 Index, const float MinU, const float MinV, const float MinW, const float Width, const float Height, const float Depth)
+	{
+		float X;
+		float Y;
+		float Z;
+		RandomKernels::CubeToBall(MinU + Width * Stream.Next(), MinV + Height * Stream.Next(), MinW + Depth * Stream.Next(), X, Y, Z);
+		OutPoints[Index] = FVector(X, Y, Z) * Radius;
+	});
+}
 
-	const float SqrtU1 = FMath::Sqrt(U1);
-	const float Sqrt1MinusU1 = FMath::Sqrt(1.0f - U1);
+void RandomUtility::RandStratifiedOnSphere(TArrayView<FVector> OutPoints, const float Radius)
+{
+	RandomKernels::FUniformStream Stream(Engine);
+	ForEachStratum2D(OutPoints.Num(), [&](const int32 Index, const float MinU, const float MinV, const float Width, const float Height)
+	{
+		float X;
+		float Y;
+		float Z;
+		RandomKernels::SquareToSphere(MinU + Width * Stream.Next(), MinV + Height * Stream.Next(), X, Y, Z);
+		OutPoints[Index] = FVector(X, Y, Z) * Radius;
+	});
+}
 
-	const float X = Sqrt1MinusU1 * FMath::Sin(U2);
-	const float Y = Sqrt1MinusU1 * FMath::Cos(U2);
-	const float Z = SqrtU1 * FMath::Sin(U3);
-	const float W = SqrtU1 * FMath::Cos(U3);
+FVector RandomUtility::RandPointOnMesh(const RandomMeshSurfaceSampler& Sampler, int32* OutTriangleIndex)
+{
+	return Sampler.RandPoint(Engine, OutTriangleIndex);
+}
 
-	return FQuat(X, Y, Z, W);
+void RandomUtility::RandPointsOnMesh(TArrayView<FVector> OutPoints, const RandomMeshSurfaceSampler& Sampler, TArrayView<int32> OutTriangleIndices)
+{
+	Sampler.RandPoints(Engine, OutPoints, OutTriangleIndices);
+}
+
+FTransform RandomUtility::RandTransformOnSpline(const RandomSplineSampler& Sampler, const float LateralOffset, const bool bAlignToTangent)
+{
+	return Sampler.RandTransform(Engine, LateralOffset, bAlignToTangent);
+}
+
+void RandomUtility::RandTransformsOnSpline(TArrayView<FTransform> OutTransforms, const RandomSplineSampler& Sampler, const float LateralOffset, const bool bAlignToTangent)
+{
+	Sampler.RandTransforms(Engine, OutTransforms, LateralOffset, bAlignToTangent);
+}
+
+void RandomUtility::RandLocationsOnSpline(TArrayView<FVector> OutLocations, const RandomSplineSampler& Sampler, const float LateralOffset)
+{
+	Sampler.RandLocations(Engine, OutLocations, LateralOffset);
+}
+
+void RandomUtility::RandTransforms(TArrayView<FTransform> OutTransforms, const RandomTransformSettings& Settings)
+{
+	ValidateTransformSettings(Settings, TEXT("RandTransforms"));
+	GenerateTransforms(Engine, OutTransforms.Num(), Settings, [&](const int32 Index, const FVector& Translation, const FQuat& Rotation, const FVector& Scale)
+	{
+		OutTransforms[Index] = FTransform(Rotation, Translation, Scale);
+	});
+}
+
+void RandomUtility::RandTransforms(TArrayView<FVector> OutTranslations, TArrayView<FQuat> OutRotations, TArrayView<FVector> OutScales, const RandomTransformSettings& Settings)
+{
+	ValidateTransformSettings(Settings, TEXT("RandTransforms"));
+	const int32 Count = ValidateTransformArrays(OutTranslations, OutRotations, OutScales, TEXT("RandTransforms"));
+	GenerateTransforms(Engine, Count, Settings, [&](const int32 Index, const FVector& Translation, const FQuat& Rotation, const FVector& Scale)
+	{
+		OutTranslations[Index] = Translation;
+		OutRotations[Index] = Rotation;
+		OutScales[Index] = Scale;
+	});
+}
+
+void RandomUtility::RandTransformsParallel(TArrayView<FTransform> OutTransforms, const RandomTransformSettings& Settings)
+{
+	ValidateTransformSettings(Settings, TEXT("RandTransformsParallel"));
+	RandomKernels::ParallelForDeterministic(Engine, OutTransforms.Num(), RandomKernels::ParallelBlockSize,
+		[OutTransforms, &Settings](RandomEngine& BlockEngine, const int32 Start, const int32 Count)
+		{
+			GenerateTransforms(BlockEngine, Count, Settings, [&](const int32 Index, const FVector& Translation, const FQuat& Rotation, const FVector& Scale)
+			{
+				OutTransforms[Start + Index] = FTransform(Rotation, Translation, Scale);
+			});
+		});
+}
+
+void RandomUtility::RandTransformsParallel(TArrayView<FVector> OutTranslations, TArrayView<FQuat> OutRotations, TArrayView<FVector> OutScales, const RandomTransformSettings& Settings)
+{
+	ValidateTransformSettings(Settings, TEXT("RandTransformsParallel"));
+	const int32 Num = ValidateTransformArrays(OutTranslations, OutRotations, OutScales, TEXT("RandTransformsParallel"));
+	RandomKernels::ParallelForDeterministic(Engine, Num, RandomKernels::ParallelBlockSize,
+		[OutTranslations, OutRotations, OutScales, &Settings](RandomEngine& BlockEngine, const int32 Start, const int32 Count)
+		{
+			GenerateTransforms(BlockEngine, Count, Settings, [&](const int32 Index, const FVector& Translation, const FQuat& Rotation, const FVector& Scale)
+			{
+				OutTranslations[Start + Index] = Translation;
+				OutRotations[Start + Index] = Rotation;
+				OutScales[Start + Index] = Scale;
+			});
+		});
+}
+
+void RandomUtility::RandWalk(TArrayView<float> OutPath, const float Start, const RandomWalkSettings& Settings)
+{
+	ValidateWalkSettings(Settings, 1);
+	const double StartPosition[1] = {Start};
+	GenerateWalk<1>(Engine, OutPath.Num(), StartPosition, Settings, [&](const int32 Index, const double (&Position)[1])
+	{
+		OutPath[Index] = static_cast<float>(Position[0]);
+	});
+}
+
+void RandomUtility::RandWalk(TArrayView<FVector2D> OutPath, const FVector2D& Start, const RandomWalkSettings& Settings)
+{
+	ValidateWalkSettings(Settings, 2);
+	const double StartPosition[2] = {Start.X, Start.Y};
+	GenerateWalk<2>(Engine, OutPath.Num(), StartPosition, Settings, [&](const int32 Index, const double (&Position)[2])
+	{
+		OutPath[Index] = FVector2D(Position[0], Position[1]);
+	});
+}
+
+void RandomUtility::RandWalk(TArrayView<FVector> OutPath, const FVector& Start, const RandomWalkSettings& Settings)
+{
+	ValidateWalkSettings(Settings, 3);
+	const double StartPosition[3] = {Start.X, Start.Y, Start.Z};
+	GenerateWalk<3>(Engine, OutPath.Num(), StartPosition, Settings, [&](const int32 Index, const double (&Position)[3])
+	{
+		OutPath[Index] = FVector(Position[0], Position[1], Position[2]);
+	});
+}
+
+RandomQuasiSequence RandomUtility::MakeQuasiSequence(const ERandomQuasiSequence Type)
+{
+	return RandomQuasiSequence(Type, Engine);
+}
+
+RandomNoise RandomUtility::MakeNoise(const ERandomNoiseType Type)
+{
+	return RandomNoise(Type, Engine);
+}
+
+FVector2D RandomUtility::QuasiPointInCircle(const RandomQuasiSequence& Sequence, const uint32 Index, const float Radius)
+{
+	const FVector2D Unit = Sequence.GetPoint2D(Index);
+	float X;
+	float Y;
+	RandomKernels::SquareToDisk(Unit.X, Unit.Y, X, Y);
+	return FVector2D(X, Y) * Radius;
+}
+
+FVector RandomUtility::QuasiPointInSphere(const RandomQuasiSequence& Sequence, const uint32 Index, const float Radius)
+{
+	const FVector Unit = Sequence.GetPoint3D(Index);
+	float X;
+	float Y;
+	float Z;
+	RandomKernels::CubeToBall(Unit.X, Unit.Y, Unit.Z, X, Y, Z);
+	return FVector(X, Y, Z) * Radius;
+}
+
+FVector RandomUtility::QuasiPointOnSphere(const RandomQuasiSequence& Sequence, const uint32 Index, const float Radius)
+{
+	const FVector2D Unit = Sequence.GetPoint2D(Index);
+	float X;
+	float Y;
+	float Z;
+	RandomKernels::SquareToSphere(Unit.X, Unit.Y, X, Y, Z);
+	return FVector(X, Y, Z) * Radius;
+}
+
+void RandomUtility::QuasiPointsInCircle(TArrayView<FVector2D> OutPoints, const RandomQuasiSequence& Sequence, const uint32 StartIndex, const float Radius)
+{
+	for (int32 i = 0; i < OutPoints.Num(); ++i)
+	{
+		OutPoints[i] = QuasiPointInCircle(Sequence, StartIndex + static_cast<uint32>(i), Radius);
+	}
+}
+
+void RandomUtility::QuasiPointsInSphere(TArrayView<FVector> OutPoints, const RandomQuasiSequence& Sequence, const uint32 StartIndex, const float Radius)
+{
+	for (int32 i = 0; i < OutPoints.Num(); ++i)
+	{
+		OutPoints[i] = QuasiPointInSphere(Sequence, StartIndex + static_cast<uint32>(i), Radius);
+	}
+}
+
+void RandomUtility::QuasiPointsOnSphere(TArrayView<FVector> OutPoints, const RandomQuasiSequence& Sequence, const uint32 StartIndex, const float Radius)
+{
+	for (int32 i = 0; i < OutPoints.Num(); ++i)
+	{
+		OutPoints[i] = QuasiPointOnSphere(Sequence, StartIndex + static_cast<uint32>(i), Radius);
+	}
 }
 
 FRotator RandomUtility::RandRotator()
@@ -196,50 +1858,69 @@ FRotator RandomUtility::RandRotator()
 	return FRotator(Pitch, Yaw, Roll);
 }
 
-template <typename T>
-T RandomUtility::RandArrayElement(const TArray<T>& Array)
+UObject* RandomUtility::RandArrayElementObject(const TArray<UObject*>& Array)
 {
-	if (Array.Num() == 0)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::RandArrayElement - Array is empty"));
-		return T{};
-	}
+	UObject* const* Element = RandArrayElement(Array);
+	return Element ? *Element : nullptr;
+}
 
-	const int32 RandomIndex = Engine.RandInt(0, Array.Num() - 1);
-	return Array[RandomIndex];
+void RandomUtility::ShuffleArrayObject(TArray<UObject*>& Array)
+{
+	ShuffleArray(Array);
 }
 
-template <typename T>
-void RandomUtility::ShuffleArray(TArray<T>& Array)
+void RandomUtility::RandIndicesK(TArrayView<int32> OutIndices, const int32 Min, const int32 Max)
 {
-	// Fisher-Yates shuffle algorithm
-	for (int32 i = Array.Num() - 1; i > 0; --i)
+	const int64 RangeSize = static_cast<int64>(Max) - Min + 1;
+	if (RangeSize <= 0 || RangeSize > MAX_int32)
 	{
-		const int32 j = Engine.RandInt(0, i);
-		Array.Swap(i, j);
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::RandIndicesK - Invalid range [%d, %d]"), Min, Max);
+		for (int32& Index : OutIndices)
+		{
+			Index = INDEX_NONE;
+		}
+		return;
 	}
-}
 
-UObject* RandomUtility::RandArrayElementObject(const TArray<UObject*>& Array)
-{
-	if (Array.Num() == 0)
+	const int32 Num = static_cast<int32>(RangeSize);
+	const int32 K = FMath::Min(OutIndices.Num(), Num);
+	if (K < OutIndices.Num())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::RandArrayElementObject - Array is empty"));
-		return nullptr;
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::RandIndicesK - %d picks requested from %d values"), OutIndices.Num(), Num);
+		for (int32 i = K; i < OutIndices.Num(); ++i)
+		{
+			OutIndices[i] = INDEX_NONE;
+		}
 	}
 
-	const int32 RandomIndex = Engine.RandInt(0, Array.Num() - 1);
-	return Array[RandomIndex];
+	// Partial Fisher-Yates over the virtual array [0, Num): step i swaps slot i with a random
+	// slot j >= i. Only the slots moved so far are stored, at most one per step.
+	TMap<int32, int32> Moved;
+	Moved.Reserve(K);
+	for (int32 i = 0; i < K; ++i)
+	{
+		const int32 j = Engine.RandInt(i, Num - 1);
+		const int32* MovedJ = Moved.Find(j);
+		const int32 ValueJ = MovedJ ? *MovedJ : j;
+		if (j != i)
+		{
+			const int32* MovedI = Moved.Find(i);
+			Moved.Add(j, MovedI ? *MovedI : i);
+		}
+		OutIndices[i] = Min + ValueJ;
+	}
 }
 
-void RandomUtility::ShuffleArrayObject(TArray<UObject*>& Array)
+TArray<int32> RandomUtility::RandIndicesK(const int32 K, const int32 Num)
 {
-	// Fisher-Yates shuffle algorithm for UObject* arrays
-	for (int32 i = Array.Num() - 1; i > 0; --i)
+	TArray<int32> Indices;
+	if (K <= 0 || Num <= 0)
 	{
-		const int32 j = Engine.RandInt(0, i);
-		Array.Swap(i, j);
+		return Indices;
 	}
+	Indices.SetNumUninitialized(FMath::Min(K, Num));
+	RandIndicesK(Indices, 0, Num - 1);
+	return Indices;
 }
 
 float RandomUtility::RandCurveValue(const FRuntimeFloatCurve& Curve)
@@ -256,6 +1937,26 @@ float RandomUtility::RandCurveAsset(const UCurveFloat& Curve)
 	return Engine.RandCurveValue(Curve.FloatCurve);
 }
 
+float RandomUtility::RandCurveAssetCached(const UCurveFloat& Curve)
+{
+	return RandomCurveSampler::FindOrBuild(Curve)->RandValue(Engine);
+}
+
+void RandomUtility::RandCurveAssetValues(const UCurveFloat& Curve, TArrayView<float> OutValues)
+{
+	RandomCurveSampler::FindOrBuild(Curve)->RandValues(Engine, OutValues);
+}
+
+float RandomUtility::RandCurveAssetTime(const UCurveFloat& Curve)
+{
+	return RandomCurveSampler::FindOrBuild(Curve)->RandTime(Engine);
+}
+
+void RandomUtility::RandCurveAssetTimes(const UCurveFloat& Curve, TArrayView<float> OutTimes)
+{
+	RandomCurveSampler::FindOrBuild(Curve)->RandTimes(Engine, OutTimes);
+}
+
 float RandomUtility::RandCurveRange(const FRuntimeFloatCurve& Curve, const float Min, const float Max)
 {
 	if (const FRichCurve* RichCurve = Curve.GetRichCurveConst())
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "HAL/PlatformTime.h"
+#include "System/RandomEngine.h"
+#include "System/TRandomEngine.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RandomEngineBenchmarkPrivate
+{
+	constexpr int32 SampleCount = 1000000;
+
+	/** Times single draws, floats and a bulk fill, and appends one report line */
+	template <typename FEngine>
+	void TimeEngine(FEngine& Engine, const TCHAR* Name, TArray<uint32>& Buffer, FString& Report)
+	{
+		// Checksum keeps the compiler from dropping the loops
+		uint32 Checksum = 0;
+
+		double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < SampleCount; ++i)
+		{
+			Checksum ^= Engine.RandUInt32();
+		}
+		const double RawSeconds = FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		float FloatSum = 0.0f;
+		for (int32 i = 0; i < SampleCount; ++i)
+		{
+			FloatSum += Engine.RandFloat(0.0f, 1.0f);
+		}
+		const double FloatSeconds = FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		Engine.RandUInt32s(Buffer);
+		const double BulkSeconds = FPlatformTime::Seconds() - Start;
+		Checksum ^= Buffer[SampleCount - 1];
+
+		const double ToNanoseconds = 1.0e9 / SampleCount;
+		Report += FString::Printf(TEXT("%-20s raw %6.2f  float %6.2f  bulk %6.2f  (checksum %08x, mean %.3f)\n"),
+			Name, RawSeconds * ToNanoseconds, FloatSeconds * ToNanoseconds, BulkSeconds * ToNanoseconds,
+			Checksum, FloatSum / SampleCount);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRandomEngineBackendBenchmarkTest, "MersenneTwisterRandom.Performance.EngineBackends",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+bool FRandomEngineBackendBenchmarkTest::RunTest(const FString& Parameters)
+{
+	using namespace RandomEngineBenchmarkPrivate;
+
+	TArray<uint32> Buffer;
+	Buffer.SetNumUninitialized(SampleCount);
+
+	FString Report = FString::Printf(TEXT("RandomEngine backends, %d samples (ns per value)\n"), SampleCount);
+
+	struct FBackendEntry
+	{
+		ERandomEngineBackend Backend;
+		const TCHAR* Name;
+	};
+	const FBackendEntry Backends[] = {
+		{ERandomEngineBackend::MersenneTwister, TEXT("MT19937")},
+		{ERandomEngineBackend::SFMT, TEXT("SFMT19937")},
+		{ERandomEngineBackend::PCG64, TEXT("PCG64")},
+		{ERandomEngineBackend::Xoshiro256PlusPlus, TEXT("xoshiro256++")},
+	};
+	for (const FBackendEntry& Entry : Backends)
+	{
+		RandomEngine Engine(12345, Entry.Backend);
+		TimeEngine(Engine, Entry.Name, Buffer, Report);
+	}
+
+	// Compile-time backends, no per-draw dispatch
+	RandomEngineMT EngineMT(12345);
+	TimeEngine(EngineMT, TEXT("RandomEngineMT"), Buffer, Report);
+	RandomEngineSFMT EngineSFMT(12345);
+	TimeEngine(EngineSFMT, TEXT("RandomEngineSFMT"), Buffer, Report);
+	RandomEnginePCG64 EnginePCG64(12345);
+	TimeEngine(EnginePCG64, TEXT("RandomEnginePCG64"), Buffer, Report);
+	RandomEngineXoshiro EngineXoshiro(12345);
+	TimeEngine(EngineXoshiro, TEXT("RandomEngineXoshiro"), Buffer, Report);
+
+	AddInfo(Report);
+
+	// Both kinds of engine must agree on the raw stream of a backend
+	RandomEngine Reference(12345, ERandomEngineBackend::PCG64);
+	RandomEnginePCG64 Fixed(12345);
+	for (int32 i = 0; i < 64; ++i)
+	{
+		const uint32 Expected = Reference.RandUInt32();
+		const uint32 Actual = Fixed.RandUInt32();
+		if (!TestEqual(TEXT("RandomEnginePCG64 follows RandomEngine with the PCG64 backend"), Actual, Expected))
+		{
+			break;
+		}
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,219 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Misc/AutomationTest.h"
+#include "System/RandomUtility.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RandomUnitVectorTestPrivate
+{
+	constexpr int32 SampleCount = 100000;
+	constexpr int32 BinCount = 32;
+
+	/** Chi-square critical value for BinCount - 1 degrees of freedom at p = 0.001 */
+	constexpr double CriticalChiSquare = 61.1;
+
+	/** Largest accepted deviation from unit length */
+	constexpr float LengthTolerance = 1.0e-4f;
+
+	/** Histogram of values in [0, 1) */
+	TArray<int32> Bin(const TArray<float>& Values)
+	{
+		TArray<int32> Counts;
+		Counts.SetNumZeroed(BinCount);
+		for (const float Value : Values)
+		{
+			++Counts[FMath::Clamp(FMath::FloorToInt(Value * BinCount), 0, BinCount - 1)];
+		}
+		return Counts;
+	}
+
+	/** Checks that values in [0, 1) are uniform (chi-square goodness of fit) */
+	bool TestUniform(FAutomationTestBase& Test, const FString& What, const TArray<float>& Values)
+	{
+		const TArray<int32> Counts = Bin(Values);
+		const double Expected = static_cast<double>(Values.Num()) / BinCount;
+		double ChiSquare = 0.0;
+		for (const int32 Count : Counts)
+		{
+			ChiSquare += FMath::Square(Count - Expected) / Expected;
+		}
+		return Test.TestTrue(FString::Printf(TEXT("%s is uniform (chi-square %.1f)"), *What, ChiSquare), ChiSquare < CriticalChiSquare);
+	}
+
+	/** Checks that two samples of the same size in [0, 1) share a distribution (two-sample chi-square) */
+	bool TestSameDistribution(FAutomationTestBase& Test, const FString& What, const TArray<float>& Scalar, const TArray<float>& Batch)
+	{
+		const TArray<int32> ScalarCounts = Bin(Scalar);
+		const TArray<int32> BatchCounts = Bin(Batch);
+		double ChiSquare = 0.0;
+		for (int32 i = 0; i < BinCount; ++i)
+		{
+			const int32 Total = ScalarCounts[i] + BatchCounts[i];
+			if (Total > 0)
+			{
+				ChiSquare += FMath::Square(static_cast<double>(ScalarCounts[i] - BatchCounts[i])) / Total;
+			}
+		}
+		return Test.TestTrue(FString::Printf(TEXT("%s matches between scalar and batch (chi-square %.1f)"), *What, ChiSquare), ChiSquare < CriticalChiSquare);
+	}
+
+	/** Maps an angle in radians to [0, 1) */
+	float AngleToUnit(const float Angle)
+	{
+		return FMath::Frac(Angle / (2.0f * PI) + 1.0f);
+	}
+
+	/**
+	 * Reduces unit vectors to z and azimuth mapped to [0, 1), both uniform on the sphere (Archimedes)
+	 * @return False if a vector is not unit length
+	 */
+	bool SphereCoordinates(FAutomationTestBase& Test, const FString& What, TArrayView<const FVector> Vectors, TArray<float>& OutHeights, TArray<float>& OutAzimuths)
+	{
+		OutHeights.Reset(Vectors.Num());
+		OutAzimuths.Reset(Vectors.Num());
+		for (const FVector& Vector : Vectors)
+		{
+			if (!FMath::IsNearlyEqual(static_cast<float>(Vector.Size()), 1.0f, LengthTolerance))
+			{
+				Test.AddError(FString::Printf(TEXT("%s: vector %s is not unit length"), *What, *Vector.ToString()));
+				return false;
+			}
+			OutHeights.Add(0.5f * (static_cast<float>(Vector.Z) + 1.0f));
+			OutAzimuths.Add(AngleToUnit(FMath::Atan2(Vector.Y, Vector.X)));
+		}
+		return true;
+	}
+
+	/**
+	 * Reduces unit 2D vectors to their angle mapped to [0, 1)
+	 * @return False if a vector is not unit length
+	 */
+	bool CircleAngles(FAutomationTestBase& Test, const FString& What, TArrayView<const FVector2D> Vectors, TArray<float>& OutAngles)
+	{
+		OutAngles.Reset(Vectors.Num());
+		for (const FVector2D& Vector : Vectors)
+		{
+			if (!FMath::IsNearlyEqual(static_cast<float>(Vector.Size()), 1.0f, LengthTolerance))
+			{
+				Test.AddError(FString::Printf(TEXT("%s: vector %s is not unit length"), *What, *Vector.ToString()));
+				return false;
+			}
+			OutAngles.Add(AngleToUnit(FMath::Atan2(Vector.Y, Vector.X)));
+		}
+		return true;
+	}
+
+	/**
+	 * Rotates a fixed axis by every quaternion, a uniform rotation takes it to a uniform point on the sphere
+	 * @return False if a quaternion is not normalized
+	 */
+	bool RotatedAxes(FAutomationTestBase& Test, const FString& What, TArrayView<const FQuat> Quats, const FVector& Axis, TArray<FVector>& OutAxes)
+	{
+		OutAxes.Reset(Quats.Num());
+		for (const FQuat& Quat : Quats)
+		{
+			if (!Quat.IsNormalized())
+			{
+				Test.AddError(FString::Printf(TEXT("%s: quaternion %s is not normalized"), *What, *Quat.ToString()));
+				return false;
+			}
+			OutAxes.Add(Quat.RotateVector(Axis));
+		}
+		return true;
+	}
+
+	/** Tests scalar and batch unit vectors against the sphere and against each other */
+	void TestSphere(FAutomationTestBase& Test, const FString& ScalarName, TArrayView<const FVector> Scalar, const FString& BatchName, TArrayView<const FVector> Batch)
+	{
+		TArray<float> ScalarHeights;
+		TArray<float> ScalarAzimuths;
+		TArray<float> BatchHeights;
+		TArray<float> BatchAzimuths;
+		if (!SphereCoordinates(Test, ScalarName, Scalar, ScalarHeights, ScalarAzimuths)
+			|| !SphereCoordinates(Test, BatchName, Batch, BatchHeights, BatchAzimuths))
+		{
+			return;
+		}
+		TestUniform(Test, ScalarName + TEXT(" z"), ScalarHeights);
+		TestUniform(Test, ScalarName + TEXT(" azimuth"), ScalarAzimuths);
+		TestUniform(Test, BatchName + TEXT(" z"), BatchHeights);
+		TestUniform(Test, BatchName + TEXT(" azimuth"), BatchAzimuths);
+		TestSameDistribution(Test, BatchName + TEXT(" z"), ScalarHeights, BatchHeights);
+		TestSameDistribution(Test, BatchName + TEXT(" azimuth"), ScalarAzimuths, BatchAzimuths);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRandomUnitVectorTest, "MersenneTwisterRandom.Distribution.UnitVectors",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FRandomUnitVectorTest::RunTest(const FString& Parameters)
+{
+	using namespace RandomUnitVectorTestPrivate;
+
+	// Fixed seeds keep the statistics reproducible, a failure is never a fluke of the run
+	{
+		RandomUtility Utility(1001);
+		TArray<FVector> Scalar;
+		Scalar.SetNumUninitialized(SampleCount);
+		for (FVector& Vector : Scalar)
+		{
+			Vector = Utility.RandVectorNormalizedRejection();
+		}
+		TArray<FVector> Batch;
+		Batch.SetNumUninitialized(SampleCount);
+		Utility.RandVectorsNormalized(Batch);
+		TestSphere(*this, TEXT("RandVectorNormalizedRejection"), Scalar, TEXT("RandVectorsNormalized"), Batch);
+	}
+	{
+		RandomUtility Utility(1002);
+		TArray<FVector2D> Scalar;
+		Scalar.SetNumUninitialized(SampleCount);
+		for (FVector2D& Vector : Scalar)
+		{
+			Vector = Utility.RandVector2DNormalizedRejection();
+		}
+		TArray<FVector2D> Batch;
+		Batch.SetNumUninitialized(SampleCount);
+		Utility.RandVectors2DNormalized(Batch);
+
+		TArray<float> ScalarAngles;
+		TArray<float> BatchAngles;
+		if (CircleAngles(*this, TEXT("RandVector2DNormalizedRejection"), Scalar, ScalarAngles)
+			&& CircleAngles(*this, TEXT("RandVectors2DNormalized"), Batch, BatchAngles))
+		{
+			TestUniform(*this, TEXT("RandVector2DNormalizedRejection angle"), ScalarAngles);
+			TestUniform(*this, TEXT("RandVectors2DNormalized angle"), BatchAngles);
+			TestSameDistribution(*this, TEXT("RandVectors2DNormalized angle"), ScalarAngles, BatchAngles);
+		}
+	}
+	{
+		RandomUtility Utility(1003);
+		TArray<FQuat> Scalar;
+		Scalar.SetNumUninitialized(SampleCount);
+		for (FQuat& Quat : Scalar)
+		{
+			Quat = Utility.RandQuatRejection();
+		}
+		TArray<FQuat> Batch;
+		Batch.SetNumUninitialized(SampleCount);
+		Utility.RandQuats(Batch);
+
+		// Two axes, so a rotation uniform about one axis only would still fail
+		for (const FVector& Axis : {FVector::XAxisVector, FVector::ZAxisVector})
+		{
+			TArray<FVector> ScalarAxes;
+			TArray<FVector> BatchAxes;
+			const FString AxisName = Axis.X > 0.0f ? TEXT(" rotated X") : TEXT(" rotated Z");
+			if (RotatedAxes(*this, TEXT("RandQuatRejection"), Scalar, Axis, ScalarAxes)
+				&& RotatedAxes(*this, TEXT("RandQuats"), Batch, Axis, BatchAxes))
+			{
+				TestSphere(*this, TEXT("RandQuatRejection") + AxisName, ScalarAxes, TEXT("RandQuats") + AxisName, BatchAxes);
+			}
+		}
+	}
+	return true;
+}
+
+#endif
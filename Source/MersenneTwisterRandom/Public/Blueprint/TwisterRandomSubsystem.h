@@ -5,8 +5,31 @@
 #include "CoreMinimal.h"
 #include "Subsystems/EngineSubsystem.h"
 #include "System/RandomEngine.h"
+#include "System/RandomStreamRegistry.h"
 #include "TwisterRandomSubsystem.generated.h"
 
+/**
+ * Handle to a named random stream owned by UTwisterRandomSubsystem
+ * Resolved once by name, then used to draw from the stream without any map lookup
+ */
+USTRUCT(BlueprintType)
+struct MERSENNETWISTERRANDOM_API FTwisterRandomStream
+{
+	GENERATED_BODY()
+
+	/** Name the stream was registered with */
+	UPROPERTY(BlueprintReadOnly, Category = "Twister Random|Stream")
+	FName Name = NAME_None;
+
+	/** Slot of the stream in the owning subsystem's contiguous stream storage */
+	int32 Index = INDEX_NONE;
+
+	/** Id of the stream registry the handle was resolved on, a handle is rejected by any other */
+	uint32 RegistryId = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+};
+
 /**
  * 
  */
@@ -17,6 +40,17 @@ class MERSENNETWISTERRANDOM_API UTwisterRandomSubsystem : public UEngineSubsyste
 
 	RandomEngine Random;
 
+	/** Named streams, each seeded from the root seed and its name */
+	RandomStreamRegistry Streams;
+
+	/**
+	 * Resolves a stream handle, logging a warning if it does not belong to this subsystem
+	 * @param Stream - Handle returned by GetStream
+	 * @param Function - Name of the calling function, for the warning
+	 * @return The stream, or nullptr if the handle is invalid
+	 */
+	RandomEngine* FindStream(const FTwisterRandomStream& Stream, const TCHAR* Function);
+
 public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 
@@ -83,6 +117,46 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Twister Random|State", meta = (DisplayName = "Advance"))
 	void Advance(const int32 Steps);
 
+	/* NAMED STREAMS */
+
+	/**
+	 * Gets (or creates) the stream registered under a name
+	 * Each stream is seeded from the root seed and its name, so draws on one stream never shift another
+	 * @param Name - Name of the stream (e.g. Loot, AI, VFX)
+	 * @return Handle to pass to the stream functions
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|Stream", meta = (DisplayName = "Get Random Stream"))
+	FTwisterRandomStream GetStream(const FName Name);
+
+	/**
+	 * Gets the engine behind a named stream for C++ callers, creating it if needed
+	 * @param Name - Name of the stream
+	 * @param Backend - Bit generator backend used if the stream is created
+	 * @return The stream's engine, valid until the next stream is created
+	 */
+	RandomEngine& GetStreamEngine(const FName Name, const ERandomEngineBackend Backend = ERandomEngineBackend::MersenneTwister);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|Stream", meta = (DisplayName = "Stream Random Float"))
+	float StreamRandFloat(const FTwisterRandomStream& Stream, const float Min, const float Max);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|Stream", meta = (DisplayName = "Stream Random Integer"))
+	int32 StreamRandInt(const FTwisterRandomStream& Stream, const int32 Min = 0, const int32 Max = 1000);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|Stream", meta = (DisplayName = "Stream Random Boolean"))
+	bool StreamRandBool(const FTwisterRandomStream& Stream, const float Probability = 0.5f);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|Stream", meta = (DisplayName = "Stream Random Gaussian"))
+	float StreamRandGaussian(const FTwisterRandomStream& Stream, const float Mean = 0.0f, const float StdDev = 1.0f);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|Stream", meta = (DisplayName = "Stream Random Weighted"))
+	int32 StreamRandWeighted(const FTwisterRandomStream& Stream, const TArray<float>& Weights);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|Stream", meta = (DisplayName = "Stream Get Current State"))
+	int32 StreamGetCurrentState(const FTwisterRandomStream& Stream);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|Stream", meta = (DisplayName = "Stream Reset"))
+	void StreamReset(const FTwisterRandomStream& Stream);
+
 	UFUNCTION(BlueprintCallable, Category = "Twister Random|Static", meta = (DisplayName = "Generate New Seed"))
 	static int32 StaticNewSeed();
 
@@ -0,0 +1,166 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Blueprint/TwisterRandomSubsystem.h"
+#include "System/RandomEngine.h"
+#include "System/RandomStreamRegistry.h"
+#include "TwisterRandomWorldSubsystem.generated.h"
+
+/**
+ * Full copy of a world's random state (main engine and every named stream)
+ * Restoring it replays the exact same sequences, whatever was drawn in between
+ */
+USTRUCT(BlueprintType)
+struct MERSENNETWISTERRANDOM_API FTwisterRandomWorldSnapshot
+{
+	GENERATED_BODY()
+
+	/** Main engine of the world at capture time */
+	RandomEngine Random{0};
+
+	/** Named streams of the world at capture time */
+	RandomStreamRegistry Streams{0};
+
+	/** False until the snapshot has been captured */
+	bool bIsValid = false;
+};
+
+/**
+ * Per-world counterpart of UTwisterRandomSubsystem
+ * Each game or PIE world owns its own engine and named streams, seeded from the engine-level
+ * root seed and the map name, so worlds simulated side by side in one process never consume
+ * each other's sequences. PIE server and clients agree unless ReseedFromEngine asks for separate
+ * instances. A map gets the same seed in PIE as in standalone and packaged runs only if game code
+ * sets the engine root seed (UTwisterRandomSubsystem::SetSeed) before the world is created, or calls
+ * ReseedFromEngine after setting it: by default the engine subsystem starts from a fresh seed every run.
+ */
+UCLASS()
+class MERSENNETWISTERRANDOM_API UTwisterRandomWorldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+	RandomEngine Random{0};
+
+	/** Named streams, each seeded from the world seed and its name */
+	RandomStreamRegistry Streams{0};
+
+	/**
+	 * Resolves a stream handle, logging a warning if it does not belong to this world
+	 * @param Stream - Handle returned by GetStream
+	 * @param Function - Name of the calling function, for the warning
+	 * @return The stream, or nullptr if the handle is invalid
+	 */
+	RandomEngine* FindStream(const FTwisterRandomStream& Stream, const TCHAR* Function);
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/**
+	 * Computes the seed of a world from the engine-level root seed and the map package name
+	 * The PIE prefix (UEDPIE_0_, UEDPIE_1_...) is stripped, so PIE matches standalone runs.
+	 * @param EngineRootSeed - Root seed of UTwisterRandomSubsystem
+	 * @param World - The world to seed
+	 * @param bSeparatePIEInstances - Whether the PIE instance ID is mixed in, giving every PIE instance its own seed
+	 * @return Seed for the world
+	 */
+	static int32 StaticWorldSeed(const int32 EngineRootSeed, const UWorld& World, const bool bSeparatePIEInstances = false);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "Get World Root Seed"))
+	int32 GetRootSeed() const;
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "Set World Seed"))
+	void SetSeed(const int32 InSeed);
+
+	/**
+	 * Re-derives the world seed from the current engine-level root seed
+	 * @param bSeparatePIEInstances - Whether each PIE instance (server, clients) gets its own seed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "Reseed World From Engine"))
+	void ReseedFromEngine(const bool bSeparatePIEInstances = false);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "World Random Float"))
+	float RandFloat(const float Min, const float Max);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "World Random Integer"))
+	int32 RandInt(const int32 Min = 0, const int32 Max = 1000);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "World Random Boolean"))
+	bool RandBool(const float Probability = 0.5f);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "World Random Gaussian"))
+	float RandGaussian(const float Mean = 0.0f, const float StdDev = 1.0f);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "World Random Weighted"))
+	int32 RandWeighted(const TArray<float>& Weights);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "World Get Current State"))
+	int32 GetCurrentState() const;
+
+	/**
+	 * Resets the world engine and every world stream to their initial state
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "World Reset"))
+	void Reset();
+
+	/* NAMED STREAMS */
+
+	/**
+	 * Gets (or creates) the world stream registered under a name
+	 * @param Name - Name of the stream
+	 * @return Handle to pass to the world stream functions
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "Get World Random Stream"))
+	FTwisterRandomStream GetStream(const FName Name);
+
+	/**
+	 * Gets the engine behind a named world stream for C++ callers, creating it if needed
+	 * @param Name - Name of the stream
+	 * @param Backend - Bit generator backend used if the stream is created
+	 * @return The stream's engine, valid until the next stream is created
+	 */
+	RandomEngine& GetStreamEngine(const FName Name, const ERandomEngineBackend Backend = ERandomEngineBackend::MersenneTwister);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "World Stream Random Float"))
+	float StreamRandFloat(const FTwisterRandomStream& Stream, const float Min, const float Max);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "World Stream Random Integer"))
+	int32 StreamRandInt(const FTwisterRandomStream& Stream, const int32 Min = 0, const int32 Max = 1000);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "World Stream Random Boolean"))
+	bool StreamRandBool(const FTwisterRandomStream& Stream, const float Probability = 0.5f);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "World Stream Random Gaussian"))
+	float StreamRandGaussian(const FTwisterRandomStream& Stream, const float Mean = 0.0f, const float StdDev = 1.0f);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "World Stream Random Weighted"))
+	int32 StreamRandWeighted(const FTwisterRandomStream& Stream, const TArray<float>& Weights);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "World Stream Get Current State"))
+	int32 StreamGetCurrentState(const FTwisterRandomStream& Stream);
+
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "World Stream Reset"))
+	void StreamReset(const FTwisterRandomStream& Stream);
+
+	/* SNAPSHOTS */
+
+	/**
+	 * Captures the full random state of this world
+	 * @return Snapshot to pass to Restore Snapshot
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "Capture World Random Snapshot"))
+	FTwisterRandomWorldSnapshot CaptureSnapshot() const;
+
+	/**
+	 * Restores a previously captured random state of this world
+	 * Stream handles resolved after the snapshot was captured become invalid
+	 * @param Snapshot - Snapshot returned by Capture Snapshot
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Twister Random|World", meta = (DisplayName = "Restore World Random Snapshot"))
+	void RestoreSnapshot(const FTwisterRandomWorldSnapshot& Snapshot);
+};
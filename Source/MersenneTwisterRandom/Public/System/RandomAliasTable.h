@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "System/RandomEngine.h"
+
+/**
+ * RandomAliasTable - Weighted index selection in O(1) (Walker's alias method, Vose's construction)
+ *
+ * Built once in O(N) from a weight list, then every pick costs two raw draws, one multiply and
+ * one compare, whatever the number of weights. Use it instead of RandomEngine::RandWeighted
+ * when the same weights are sampled many times. A built table is read-only and can be sampled
+ * from several threads, each with its own engine.
+ */
+class MERSENNETWISTERRANDOM_API RandomAliasTable
+{
+public:
+	RandomAliasTable() = default;
+
+	/**
+	 * Constructor - Builds the table from weights
+	 * @param Weights - Relative weights, entries <= 0 are never picked
+	 */
+	explicit RandomAliasTable(TArrayView<const float> Weights);
+
+	/**
+	 * Rebuilds the table from weights
+	 * @param Weights - Relative weights, entries <= 0 are never picked
+	 * @return False if no weight is positive, the table is then empty
+	 */
+	bool Build(TArrayView<const float> Weights);
+
+	/** Number of entries, 0 if the table is empty */
+	int32 Num() const { return Thresholds.Num(); }
+
+	bool IsValid() const { return Thresholds.Num() > 0; }
+
+	/** Sum of the positive weights the table was built from */
+	double GetTotalWeight() const { return TotalWeight; }
+
+	/**
+	 * Picks an index with probability proportional to its weight
+	 * @param Engine - Engine providing the two raw draws
+	 * @return Picked index, or INDEX_NONE if the table is empty
+	 */
+	int32 Sample(RandomEngine& Engine) const;
+
+	/**
+	 * Picks an index from two raw draws, for batch code that draws in bulk
+	 * @param RawIndex - Raw draw selecting the column
+	 * @param RawCoin - Raw draw selecting between the column and its alias
+	 * @return Picked index, the table must not be empty
+	 */
+	FORCEINLINE int32 Sample(const uint32 RawIndex, const uint32 RawCoin) const
+	{
+		// Multiply-shift maps the draw to a column, bias is below Num / 2^32
+		const int32 Column = static_cast<int32>((static_cast<uint64>(RawIndex) * static_cast<uint64>(Thresholds.Num())) >> 32);
+		return RawCoin < Thresholds[Column] ? Column : Aliases[Column];
+	}
+
+private:
+	/** Probability of keeping the column, as a 32-bit fraction */
+	TArray<uint32> Thresholds;
+
+	/** Index picked when the column is not kept */
+	TArray<int32> Aliases;
+
+	double TotalWeight = 0.0;
+};
+
+/**
+ * RandomAliasTableCache - Alias table of an array's weights, rebuilt only when the array changes
+ *
+ * The owner of the array keeps a version number and bumps it whenever elements or weights
+ * change. Prepare compares it and the element count with the last build and only reads the
+ * weights again when they differ, so repeated picks from a stable array cost O(1) each.
+ * Preparing is not thread-safe, a prepared table can be sampled from several threads.
+ */
+class RandomAliasTableCache
+{
+public:
+	/**
+	 * Gets the table of an array's weights, rebuilding it if the version or the size changed
+	 * @param Array - Elements to weigh
+	 * @param Version - The owner's version of the array
+	 * @param GetWeight - Projection float(const T&) returning the weight of an element, entries <= 0 are never picked
+	 * @return The table, empty if no weight is positive
+	 */
+	template <typename T, typename FProjection>
+	const RandomAliasTable& Prepare(TArrayView<T> Array, const uint32 Version, FProjection&& GetWeight);
+
+	/** Forces the next Prepare to rebuild */
+	void Invalidate() { bPrepared = false; }
+
+	const RandomAliasTable& GetTable() const { return Table; }
+
+private:
+	RandomAliasTable Table;
+
+	/** Weights of the last build, kept so rebuilds reuse the allocation */
+	TArray<float> Weights;
+
+	uint32 PreparedVersion = 0;
+	int32 PreparedNum = 0;
+	bool bPrepared = false;
+};
+
+template <typename T, typename FProjection>
+const RandomAliasTable& RandomAliasTableCache::Prepare(TArrayView<T> Array, const uint32 Version, FProjection&& GetWeight)
+{
+	if (bPrepared && Version == PreparedVersion && Array.Num() == PreparedNum)
+	{
+		return Table;
+	}
+
+	Weights.Reset(Array.Num());
+	for (const T& Element : Array)
+	{
+		Weights.Add(static_cast<float>(GetWeight(Element)));
+	}
+	Table.Build(Weights);
+
+	bPrepared = true;
+	PreparedVersion = Version;
+	PreparedNum = Array.Num();
+	return Table;
+}
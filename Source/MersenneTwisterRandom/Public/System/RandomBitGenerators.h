@@ -0,0 +1,256 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <random>
+#include "CoreMinimal.h"
+#include "Misc/TVariant.h"
+
+/**
+ * Bit generator backends usable by RandomEngine
+ *
+ * Every backend is a standard UniformRandomBitGenerator, so std distributions accept them
+ * directly. They trade period and state size for speed:
+ * - MersenneTwister: std::mt19937, 2.5KB state, period 2^19937-1 (default, gameplay)
+ * - SFMT: SIMD-oriented Fast Mersenne Twister, 2.5KB state, period 2^19937-1
+ * - PCG64: 128-bit LCG with XSL-RR output, 16 bytes state, period 2^128, O(log n) skip ahead
+ * - Xoshiro256PlusPlus: 32 bytes state, period 2^256-1, linear discard (cosmetic effects)
+ *
+ * PCG64 and Xoshiro256PlusPlus produce 64 bits per step, but RandomBitGenerator (and
+ * TRandomEngine) keep only the high 32 bits: the low half of every step is thrown away,
+ * so their per-value cost is a full 64-bit step.
+ */
+enum class ERandomEngineBackend : uint8
+{
+	MersenneTwister,
+	SFMT,
+	PCG64,
+	Xoshiro256PlusPlus
+};
+
+/**
+ * SFMT19937 - SIMD-oriented Fast Mersenne Twister (Saito & Matsumoto)
+ * Same period as mt19937 but works on 128-bit words, which the twist loop vectorizes well.
+ * Matches the reference implementation output for init_gen_rand(seed).
+ */
+class MERSENNETWISTERRANDOM_API SFMT19937
+{
+public:
+	using result_type = uint32;
+
+	/** Number of 128-bit state words */
+	static constexpr int32 StateSize128 = 156;
+
+	/** Number of 32-bit state words */
+	static constexpr int32 StateSize32 = StateSize128 * 4;
+
+	explicit SFMT19937(const uint32 InSeed = 5489u);
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return MAX_uint32; }
+
+	FORCEINLINE result_type operator()()
+	{
+		if (Index >= StateSize32)
+		{
+			GenerateAll();
+		}
+		return State[Index++];
+	}
+
+	void discard(uint64 Count);
+
+private:
+	/** State, read 32 bits at a time and twisted 128 bits at a time */
+	alignas(16) uint32 State[StateSize32];
+
+	/** Next 32-bit word to return */
+	int32 Index;
+
+	/** Regenerates the whole state block */
+	void GenerateAll();
+};
+
+/**
+ * PCG64 - Permuted congruential generator, 128-bit state with XSL-RR 64-bit output (O'Neill)
+ * Same stream as pcg-cpp's pcg64 seeded with an integer.
+ */
+class MERSENNETWISTERRANDOM_API PCG64
+{
+public:
+	using result_type = uint64;
+
+	explicit PCG64(const uint64 InSeed = 0xCAFEF00DD15EA5E5ull);
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return MAX_uint64; }
+
+	FORCEINLINE result_type operator()()
+	{
+		Step();
+		// XSL-RR: fold the halves, rotate by the top 6 bits
+		const uint64 Folded = StateHigh ^ StateLow;
+		const uint32 Rotation = static_cast<uint32>(StateHigh >> 58);
+		return (Folded >> Rotation) | (Folded << ((64 - Rotation) & 63));
+	}
+
+	/** Skips ahead in O(log Count) */
+	void discard(uint64 Count);
+
+private:
+	uint64 StateHigh;
+	uint64 StateLow;
+
+	static constexpr uint64 MultiplierHigh = 2549297995355413924ull;
+	static constexpr uint64 MultiplierLow = 4865540595714422341ull;
+	static constexpr uint64 IncrementHigh = 6364136223846793005ull;
+	static constexpr uint64 IncrementLow = 1442695040888963407ull;
+
+	/** 64x64 -> 128-bit multiplication, portable across compilers */
+	static FORCEINLINE void Multiply64(const uint64 A, const uint64 B, uint64& OutHigh, uint64& OutLow)
+	{
+		const uint64 ALow = A & 0xFFFFFFFFull;
+		const uint64 AHigh = A >> 32;
+		const uint64 BLow = B & 0xFFFFFFFFull;
+		const uint64 BHigh = B >> 32;
+		const uint64 LowLow = ALow * BLow;
+		const uint64 HighLow = AHigh * BLow;
+		const uint64 LowHigh = ALow * BHigh;
+		const uint64 HighHigh = AHigh * BHigh;
+		const uint64 Cross = (LowLow >> 32) + (HighLow & 0xFFFFFFFFull) + LowHigh;
+		OutHigh = HighHigh + (HighLow >> 32) + (Cross >> 32);
+		OutLow = (Cross << 32) | (LowLow & 0xFFFFFFFFull);
+	}
+
+	/** (AHigh:ALow) * (BHigh:BLow) mod 2^128 */
+	static FORCEINLINE void Multiply128(const uint64 AHigh, const uint64 ALow, const uint64 BHigh, const uint64 BLow, uint64& OutHigh, uint64& OutLow)
+	{
+		uint64 High;
+		Multiply64(ALow, BLow, High, OutLow);
+		OutHigh = High + AHigh * BLow + ALow * BHigh;
+	}
+
+	/** (AHigh:ALow) + (BHigh:BLow) mod 2^128 */
+	static FORCEINLINE void Add128(uint64& AHigh, uint64& ALow, const uint64 BHigh, const uint64 BLow)
+	{
+		const uint64 Low = ALow + BLow;
+		AHigh = AHigh + BHigh + (Low < ALow ? 1 : 0);
+		ALow = Low;
+	}
+
+	FORCEINLINE void Step()
+	{
+		Multiply128(StateHigh, StateLow, MultiplierHigh, MultiplierLow, StateHigh, StateLow);
+		Add128(StateHigh, StateLow, IncrementHigh, IncrementLow);
+	}
+};
+
+/**
+ * Xoshiro256PlusPlus - xoshiro256++ 1.0 (Blackman & Vigna)
+ * The 64-bit seed is expanded to the 256-bit state with SplitMix64, as the authors recommend.
+ */
+class MERSENNETWISTERRANDOM_API Xoshiro256PlusPlus
+{
+public:
+	using result_type = uint64;
+
+	explicit Xoshiro256PlusPlus(const uint64 InSeed = 0);
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return MAX_uint64; }
+
+	FORCEINLINE result_type operator()()
+	{
+		const uint64 Result = RotateLeft(S[0] + S[3], 23) + S[0];
+		const uint64 T = S[1] << 17;
+		S[2] ^= S[0];
+		S[3] ^= S[1];
+		S[1] ^= S[2];
+		S[0] ^= S[3];
+		S[2] ^= T;
+		S[3] = RotateLeft(S[3], 45);
+		return Result;
+	}
+
+	/**
+	 * Skips ahead one step at a time, O(Count)
+	 * The xoshiro jump polynomials only cover fixed distances (2^128, 2^192), not arbitrary counts
+	 */
+	void discard(uint64 Count);
+
+private:
+	uint64 S[4];
+
+	static FORCEINLINE uint64 RotateLeft(const uint64 X, const int32 K)
+	{
+		return (X << K) | (X >> (64 - K));
+	}
+};
+
+/**
+ * RandomBitGenerator - Runtime-selected backend behind RandomEngine
+ *
+ * Presents every backend as a 32-bit generator (64-bit backends return their high word and
+ * drop the low one), so std distributions consume the same number of draws and the MersenneTwister backend
+ * reproduces the exact sequences of the plain std::mt19937 engine.
+ */
+class MERSENNETWISTERRANDOM_API RandomBitGenerator
+{
+public:
+	using result_type = uint32;
+
+	RandomBitGenerator(const ERandomEngineBackend InBackend, const uint32 InSeed);
+
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return MAX_uint32; }
+
+	ERandomEngineBackend GetBackend() const { return Backend; }
+
+	FORCEINLINE result_type operator()()
+	{
+		switch (Backend)
+		{
+		case ERandomEngineBackend::SFMT:
+			return State.Get<SFMT19937>()();
+		case ERandomEngineBackend::PCG64:
+			return static_cast<uint32>(State.Get<PCG64>()() >> 32);
+		case ERandomEngineBackend::Xoshiro256PlusPlus:
+			return static_cast<uint32>(State.Get<Xoshiro256PlusPlus>()() >> 32);
+		default:
+			return static_cast<uint32>(State.Get<std::mt19937>()());
+		}
+	}
+
+	void discard(const uint64 Count);
+
+	/**
+	 * Fills an array with raw values, the backend is selected once for the whole array
+	 * @param OutValues - Array to fill, every element is overwritten
+	 */
+	void Fill(TArrayView<uint32> OutValues);
+
+	/**
+	 * Calls a functor with the concrete backend generator, for loops that should not dispatch per draw
+	 * @param Func - Callable taking any backend generator by reference
+	 */
+	template <typename FuncType>
+	decltype(auto) Visit(FuncType&& Func)
+	{
+		switch (Backend)
+		{
+		case ERandomEngineBackend::SFMT:
+			return Func(State.Get<SFMT19937>());
+		case ERandomEngineBackend::PCG64:
+			return Func(State.Get<PCG64>());
+		case ERandomEngineBackend::Xoshiro256PlusPlus:
+			return Func(State.Get<Xoshiro256PlusPlus>());
+		default:
+			return Func(State.Get<std::mt19937>());
+		}
+	}
+
+private:
+	ERandomEngineBackend Backend;
+
+	TVariant<std::mt19937, SFMT19937, PCG64, Xoshiro256PlusPlus> State;
+};
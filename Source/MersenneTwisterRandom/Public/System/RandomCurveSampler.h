@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "System/RandomEngine.h"
+
+class UCurveFloat;
+struct FRichCurve;
+
+/**
+ * RandomCurveSampler - Baked lookup tables of a float curve for repeated sampling
+ *
+ * Built once by evaluating the curve at evenly spaced times between its first and last key.
+ * A random value then costs one raw draw and a linear interpolation in the table, instead of
+ * a key search and a full FRichCurve::Eval. The sampler also bakes an inverse CDF that treats
+ * the curve as a density over time (negative values count as zero), so times can be drawn
+ * where the curve is high: spawn rates, event probability over a lifetime.
+ *
+ * The table is interpolated linearly, so steps (constant keys) and other jumps are smoothed
+ * over one table entry. Use FRichCurve::Eval where exact stepped values matter.
+ *
+ * A built sampler is read-only and can be shared by several threads, each with its own engine.
+ * FindOrBuild keeps one shared sampler per UCurveFloat asset, dropped when the asset is edited,
+ * reloaded or garbage collected.
+ */
+class MERSENNETWISTERRANDOM_API RandomCurveSampler
+{
+public:
+	/** Number of table entries used when none is given */
+	static constexpr int32 DefaultResolution = 256;
+
+	RandomCurveSampler() = default;
+
+	/**
+	 * Bakes the tables of a curve
+	 * @param Curve - Curve to bake, its first and last keys give the time range
+	 * @param Resolution - Number of table entries, at least 2
+	 * @return False if the curve has no keys, the sampler is then empty
+	 */
+	bool Build(const FRichCurve& Curve, const int32 Resolution = DefaultResolution);
+
+	bool IsValid() const { return Values.Num() > 0; }
+
+	/** True if the curve has a positive area, RandTime needs it */
+	bool HasDensity() const { return InverseCdf.Num() > 0; }
+
+	float GetMinTime() const { return MinTime; }
+
+	float GetMaxTime() const { return MaxTime; }
+
+	/**
+	 * Reads the baked curve
+	 * @param Time - Time to read, clamped to the key range
+	 * @return Interpolated value, or 0 if the sampler is empty
+	 */
+	float Eval(const float Time) const;
+
+	/**
+	 * Gets the curve value at a uniform random time between the first and last key
+	 * @param Engine - Engine providing the draw
+	 * @return Curve value, or 0 if the sampler is empty
+	 */
+	float RandValue(RandomEngine& Engine) const;
+
+	/**
+	 * Gets a random time distributed like the curve values (inverse CDF)
+	 * @param Engine - Engine providing the draw
+	 * @return Time in the key range, or the first key time if the curve has no positive area
+	 */
+	float RandTime(RandomEngine& Engine) const;
+
+	/**
+	 * Fills an array with curve values at uniform random times
+	 * @param Engine - Engine providing the bulk raw draws
+	 * @param OutValues - Array to fill, every element is overwritten
+	 */
+	void RandValues(RandomEngine& Engine, TArrayView<float> OutValues) const;
+
+	/**
+	 * Fills an array with random times distributed like the curve values
+	 * @param Engine - Engine providing the bulk raw draws
+	 * @param OutTimes - Array to fill, every element is overwritten
+	 */
+	void RandTimes(RandomEngine& Engine, TArrayView<float> OutTimes) const;
+
+	/**
+	 * Gets the shared sampler of a curve asset, baking it on first use
+	 * Safe to call from any thread. The returned sampler stays valid while it is held, even if
+	 * the asset changes: later calls then return a new sampler.
+	 * @param Curve - Curve asset
+	 * @return Shared sampler, empty (IsValid false) if the curve has no keys
+	 */
+	static TSharedRef<const RandomCurveSampler, ESPMode::ThreadSafe> FindOrBuild(const UCurveFloat& Curve);
+
+	/**
+	 * Drops the cached sampler of a curve asset, for curves changed from code at runtime
+	 * @param Curve - Curve asset
+	 */
+	static void Invalidate(const UCurveFloat& Curve);
+
+	/** Drops every cached sampler */
+	static void InvalidateAll();
+
+	/** Hooks the cache to asset edit, reload and garbage collection events, called by the module */
+	static void RegisterCacheEvents();
+
+	/** Unhooks the cache and drops every cached sampler, called by the module */
+	static void UnregisterCacheEvents();
+
+private:
+	float MinTime = 0.0f;
+	float MaxTime = 0.0f;
+
+	/** Converts a time offset from MinTime to a fractional table position */
+	float TimeToPosition = 0.0f;
+
+	/** Curve values at evenly spaced times, MinTime first and MaxTime last */
+	TArray<float> Values;
+
+	/** Times at evenly spaced cumulative area levels, 0 first and the total area last */
+	TArray<float> InverseCdf;
+
+	/** Interpolates a table at a fractional position in [0, Num - 1] */
+	static FORCEINLINE float Lerp(const TArray<float>& Table, const float Position);
+};
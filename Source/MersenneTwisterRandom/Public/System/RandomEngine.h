@@ -4,6 +4,7 @@
 
 #include <random>
 #include "CoreMinimal.h"
+#include "System/RandomBitGenerators.h"
 
 /**
  * RandomEngine - A high-quality random number generator wrapper
@@ -11,6 +12,8 @@
  * This class provides a consistent interface for generating random numbers using
  * the Mersenne Twister (mt19937) algorithm. It maintains state for seeded generation
  * and provides both instance-based and static methods for different use cases.
+ * Faster backends (SFMT, PCG64, xoshiro256++) can be selected at construction for
+ * cosmetic randomness, every function works the same on all of them.
  * 
  * Features:
  * - Seeded random generation for reproducible results
@@ -18,26 +21,37 @@
  * - High-quality random number generation
  * - Support for integers, floats, and booleans
  * - Static methods for one-shot generation
+ * - Selectable bit generator backend
  */
 class MERSENNETWISTERRANDOM_API RandomEngine
 {
 	/** The seed used to initialize the random generator */
 	int32 Seed;
 
-	/** Mersenne Twister random number generator */
-	std::mt19937 Generator;
+	/** Bit generator backend (Mersenne Twister unless selected otherwise) */
+	RandomBitGenerator Generator;
 
 	/** Number of values generated since initialization */
 	uint32 GeneratedCount;
 
+	/**
+	 * Draws a uniform integer in [0, Range) with a kernel selected at compile time
+	 * Powers of two only mask the raw draw, other ranges use a multiply-shift with a
+	 * constant rejection threshold (Lemire), so no division happens at runtime
+	 * Counts every raw draw in GeneratedCount, rejected ones included, so replays stay in sync
+	 */
+	template <uint32 Range>
+	uint32 RandBelow();
+
 public:
 	RandomEngine();
 
 	/**
 	 * Constructor - Initializes the random engine with a specific seed
 	 * @param InSeed - The seed value for reproducible random generation
+	 * @param InBackend - Bit generator backend, Mersenne Twister keeps the historical sequences
 	 */
-	RandomEngine(int32 InSeed);
+	RandomEngine(int32 InSeed, ERandomEngineBackend InBackend = ERandomEngineBackend::MersenneTwister);
 
 	/**
 	 * Destructor
@@ -46,6 +60,12 @@ public:
 
 	int32 GetRootSeed() const;
 
+	/**
+	 * Gets the bit generator backend selected at construction
+	 * @return The backend
+	 */
+	ERandomEngineBackend GetBackend() const;
+
 	/**
 	 * Generates a random integer within the specified range (inclusive)
 	 * @param Min - Minimum value (inclusive), defaults to 0
@@ -54,6 +74,56 @@ public:
 	 */
 	int32 RandInt(const int32 Min = 0, const int32 Max = 1000);
 
+	/**
+	 * Generates a random integer within a range known at compile time (inclusive)
+	 * Faster than RandInt(Min, Max) for constant bounds such as dice or color channels,
+	 * but produces a different sequence for the same seed
+	 * @tparam Min - Minimum value (inclusive)
+	 * @tparam Max - Maximum value (inclusive)
+	 * @return Random integer between Min and Max
+	 */
+	template <int32 Min, int32 Max>
+	int32 RandInt();
+
+	/**
+	 * Fills an array with random integers within a range known at compile time (inclusive)
+	 * Raw values are drawn in chunks and mapped in a branch-free pass, only the rare rejected
+	 * slots are redrawn afterwards, so the values differ from repeated RandInt<Min, Max> calls
+	 * @tparam Min - Minimum value (inclusive)
+	 * @tparam Max - Maximum value (inclusive)
+	 * @param OutValues - Array to fill, every element is overwritten
+	 */
+	template <int32 Min, int32 Max>
+	void RandInts(TArrayView<int32> OutValues);
+
+	/**
+	 * Generates a random index in [0, N) for a count known at compile time
+	 * @tparam N - Number of possible indices
+	 * @return Random index between 0 and N-1
+	 */
+	template <int32 N>
+	int32 RandIndex();
+
+	/**
+	 * Fills an array with random indices in [0, N) for a count known at compile time
+	 * @tparam N - Number of possible indices
+	 * @param OutIndices - Array to fill, every element is overwritten
+	 */
+	template <int32 N>
+	void RandIndices(TArrayView<int32> OutIndices);
+
+	/**
+	 * Generates a raw 32-bit value straight from the generator
+	 * @return Uniform value over the full uint32 range
+	 */
+	uint32 RandUInt32();
+
+	/**
+	 * Fills an array with raw 32-bit values, the backend is dispatched once for the whole array
+	 * @param OutValues - Array to fill, every element is overwritten
+	 */
+	void RandUInt32s(TArrayView<uint32> OutValues);
+
 	/**
 	 * Generates a random float within the specified range (inclusive)
 	 * @param Min - Minimum value (inclusive), defaults to 0.0f
@@ -62,6 +132,15 @@ public:
 	 */
 	float RandFloat(const float Min = 0.0f, const float Max = 1.0f);
 
+	/**
+	 * Fills an array with uniform floats from bulk raw draws (one raw draw per value)
+	 * Faster than calling RandFloat in a loop, but produces a different sequence for the same seed
+	 * @param OutValues - Array to fill, every element is overwritten
+	 * @param Min - Minimum value (inclusive), defaults to 0.0f
+	 * @param Max - Maximum value (exclusive), defaults to 1.0f
+	 */
+	void RandFloats(TArrayView<float> OutValues, const float Min = 0.0f, const float Max = 1.0f);
+
 	/**
 	 * Generates a random float with bias toward a specific value
 	 * Uses multiple samples and selects the one closest to bias point
@@ -197,6 +276,23 @@ public:
 	 */
 	static int32 StaticNewSeed();
 
+	/**
+	 * Derives a child seed from a root seed and a key
+	 * The same root seed and key always produce the same child seed, on every platform
+	 * @param RootSeed - The seed of the parent generator
+	 * @param Key - Identifier of the child stream
+	 * @return A well-mixed seed for the child generator
+	 */
+	static int32 StaticDeriveSeed(const int32 RootSeed, const uint32 Key);
+
+	/**
+	 * Derives a child seed from a root seed and a name (case-insensitive)
+	 * @param RootSeed - The seed of the parent generator
+	 * @param Name - Name of the child stream
+	 * @return A well-mixed seed for the child generator
+	 */
+	static int32 StaticDeriveSeed(const int32 RootSeed, const FName Name);
+
 	/**
 	 * Generates a random integer using Unreal's built-in random generator (lower quality)
 	 * @param Min - Minimum value (inclusive)
@@ -242,3 +338,128 @@ public:
 	 */
 	static FGuid StaticNewGuid();
 };
+
+template <uint32 Range>
+uint32 RandomEngine::RandBelow()
+{
+	static_assert(Range > 1, "RandBelow needs at least two possible values");
+
+	if constexpr ((Range & (Range - 1)) == 0)
+	{
+		// Power of two: every backend delivers 32 uniform bits, keep the low ones
+		GeneratedCount++;
+		return static_cast<uint32>(Generator()) & (Range - 1);
+	}
+	else
+	{
+		// Multiply-shift: the high word of Raw * Range is uniform once the biased low words are rejected
+		constexpr uint32 Threshold = (0u - Range) % Range;
+		GeneratedCount++;
+		uint64 Product = static_cast<uint64>(static_cast<uint32>(Generator())) * Range;
+		while (static_cast<uint32>(Product) < Threshold)
+		{
+			GeneratedCount++;
+			Product = static_cast<uint64>(static_cast<uint32>(Generator())) * Range;
+		}
+		return static_cast<uint32>(Product >> 32);
+	}
+}
+
+template <int32 Min, int32 Max>
+int32 RandomEngine::RandInt()
+{
+	static_assert(Min <= Max, "RandInt<Min, Max> needs Min <= Max");
+	constexpr uint64 Range = static_cast<uint64>(static_cast<int64>(Max) - static_cast<int64>(Min)) + 1;
+
+	// A single possible value draws nothing, so it must not count either
+	if constexpr (Range == 1)
+	{
+		return Min;
+	}
+	else if constexpr (Range == (1ull << 32))
+	{
+		GeneratedCount++;
+		return static_cast<int32>(static_cast<uint32>(Generator()));
+	}
+	else
+	{
+		return static_cast<int32>(static_cast<uint32>(Min) + RandBelow<static_cast<uint32>(Range)>());
+	}
+}
+
+template <int32 Min, int32 Max>
+void RandomEngine::RandInts(TArrayView<int32> OutValues)
+{
+	static_assert(Min <= Max, "RandInts<Min, Max> needs Min <= Max");
+	constexpr uint64 Range = static_cast<uint64>(static_cast<int64>(Max) - static_cast<int64>(Min)) + 1;
+
+	if constexpr (Range == 1)
+	{
+		for (int32& Value : OutValues)
+		{
+			Value = Min;
+		}
+	}
+	else
+	{
+		constexpr int32 ChunkSize = 256;
+		uint32 Raw[ChunkSize];
+		for (int32 Start = 0; Start < OutValues.Num(); Start += ChunkSize)
+		{
+			const int32 Count = FMath::Min(ChunkSize, OutValues.Num() - Start);
+			RandUInt32s(TArrayView<uint32>(Raw, Count));
+			int32* Out = OutValues.GetData() + Start;
+
+			if constexpr (Range == (1ull << 32))
+			{
+				for (int32 i = 0; i < Count; ++i)
+				{
+					Out[i] = static_cast<int32>(Raw[i]);
+				}
+			}
+			else if constexpr ((Range & (Range - 1)) == 0)
+			{
+				for (int32 i = 0; i < Count; ++i)
+				{
+					Out[i] = static_cast<int32>(static_cast<uint32>(Min) + (Raw[i] & static_cast<uint32>(Range - 1)));
+				}
+			}
+			else
+			{
+				constexpr uint32 Threshold = (0u - static_cast<uint32>(Range)) % static_cast<uint32>(Range);
+				bool bAnyRejected = false;
+				for (int32 i = 0; i < Count; ++i)
+				{
+					const uint64 Product = static_cast<uint64>(Raw[i]) * Range;
+					Out[i] = static_cast<int32>(static_cast<uint32>(Min) + static_cast<uint32>(Product >> 32));
+					bAnyRejected |= static_cast<uint32>(Product) < Threshold;
+				}
+
+				// A slot is rejected with probability Threshold / 2^32, redraw those slots only
+				if (bAnyRejected)
+				{
+					for (int32 i = 0; i < Count; ++i)
+					{
+						if (static_cast<uint32>(static_cast<uint64>(Raw[i]) * Range) < Threshold)
+						{
+							Out[i] = static_cast<int32>(static_cast<uint32>(Min) + RandBelow<static_cast<uint32>(Range)>());
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+template <int32 N>
+int32 RandomEngine::RandIndex()
+{
+	static_assert(N > 0, "RandIndex<N> needs at least one index");
+	return RandInt<0, N - 1>();
+}
+
+template <int32 N>
+void RandomEngine::RandIndices(TArrayView<int32> OutIndices)
+{
+	RandInts<0, N - 1>(OutIndices);
+}
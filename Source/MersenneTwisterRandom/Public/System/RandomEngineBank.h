@@ -0,0 +1,402 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "System/RandomEngine.h"
+
+/**
+ * RandomEngineBank - Several independent Mersenne Twister generators advanced together
+ *
+ * The state of every lane is interleaved (state word i of all lanes is contiguous), so the
+ * twist and tempering loops run over lanes in their innermost loop and compile down to
+ * vector instructions: one pass regenerates 624 words for every lane at once.
+ *
+ * Lane L is seeded with RandomEngine::StaticDeriveSeed(RootSeed, L) and produces exactly
+ * the raw sequence of std::mt19937 with that seed, however it is consumed (through its
+ * handle one value at a time, or in bulk for all lanes).
+ *
+ * Bulk fills take the vector path only while every lane sits on the same state word. A draw
+ * through a Lane handle moves that lane alone, and from then on bulk fills fall back to one
+ * NextLane call per value until every lane has again drawn the same number of values modulo
+ * 624. Call Resynchronize after mixing handle draws with bulk fills to get the vector path back.
+ *
+ * The state is LaneCount * 2.5KB, allocate banks on the heap.
+ *
+ * @tparam LaneCount - Number of generators in the bank (8 or 16 match 256 and 512-bit vectors)
+ */
+template <int32 LaneCount = 8>
+class RandomEngineBank
+{
+	static_assert(LaneCount > 0 && (LaneCount & (LaneCount - 1)) == 0, "RandomEngineBank needs a power of two lane count");
+
+	/** mt19937 parameters */
+	static constexpr int32 StateSize = 624;
+	static constexpr int32 ShiftSize = 397;
+	static constexpr uint32 MatrixA = 0x9908B0DFu;
+	static constexpr uint32 UpperMask = 0x80000000u;
+	static constexpr uint32 LowerMask = 0x7FFFFFFFu;
+
+	/** Interleaved state: State[i][L] is word i of lane L */
+	alignas(64) uint32 State[StateSize][LaneCount];
+
+	/** Next state word to temper, per lane */
+	int32 Cursor[LaneCount];
+
+	/** Number of raw values generated per lane since initialization */
+	uint32 GeneratedCount[LaneCount];
+
+	/** The seed every lane is derived from */
+	int32 RootSeed;
+
+	/** Extracts one mt19937 output from a state word */
+	static FORCEINLINE uint32 Temper(uint32 Y)
+	{
+		Y ^= Y >> 11;
+		Y ^= (Y << 7) & 0x9D2C5680u;
+		Y ^= (Y << 15) & 0xEFC60000u;
+		Y ^= Y >> 18;
+		return Y;
+	}
+
+	/** Computes one twisted state word from its three mt19937 inputs */
+	static FORCEINLINE uint32 TwistWord(const uint32 Current, const uint32 Next, const uint32 Far)
+	{
+		const uint32 Y = (Current & UpperMask) | (Next & LowerMask);
+		// Branchless odd test keeps the lane loop vectorizable
+		return Far ^ (Y >> 1) ^ ((0u - (Y & 1u)) & MatrixA);
+	}
+
+	/** Regenerates the state of every lane, lanes are the inner loop */
+	void TwistAll()
+	{
+		for (int32 i = 0; i < StateSize - ShiftSize; ++i)
+		{
+			for (int32 L = 0; L < LaneCount; ++L)
+			{
+				State[i][L] = TwistWord(State[i][L], State[i + 1][L], State[i + ShiftSize][L]);
+			}
+		}
+		for (int32 i = StateSize - ShiftSize; i < StateSize - 1; ++i)
+		{
+			for (int32 L = 0; L < LaneCount; ++L)
+			{
+				State[i][L] = TwistWord(State[i][L], State[i + 1][L], State[i + ShiftSize - StateSize][L]);
+			}
+		}
+		for (int32 L = 0; L < LaneCount; ++L)
+		{
+			State[StateSize - 1][L] = TwistWord(State[StateSize - 1][L], State[0][L], State[ShiftSize - 1][L]);
+			Cursor[L] = 0;
+		}
+	}
+
+	/** Regenerates the state of a single lane, used when lanes are consumed unevenly */
+	void TwistLane(const int32 L)
+	{
+		for (int32 i = 0; i < StateSize; ++i)
+		{
+			State[i][L] = TwistWord(State[i][L], State[(i + 1) % StateSize][L], State[(i + ShiftSize) % StateSize][L]);
+		}
+		Cursor[L] = 0;
+	}
+
+	/** True when every lane sits on the same state word, which allows whole-row processing */
+	bool IsLockstep() const
+	{
+		for (int32 L = 1; L < LaneCount; ++L)
+		{
+			if (Cursor[L] != Cursor[0])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+public:
+	/**
+	 * Lightweight handle on one lane of a bank
+	 * Copyable, holds no state of its own: draws advance the lane inside the bank
+	 */
+	class Lane
+	{
+		RandomEngineBank* Bank;
+		int32 Index;
+
+	public:
+		Lane(RandomEngineBank& InBank, const int32 InIndex): Bank(&InBank), Index(InIndex)
+		{
+		}
+
+		int32 GetLaneIndex() const { return Index; }
+
+		/**
+		 * Generates a raw 32-bit value from this lane
+		 * @return Uniform value over the full uint32 range
+		 */
+		uint32 RandUInt32() { return Bank->NextLane(Index); }
+
+		/**
+		 * Generates a random integer within the specified range (inclusive)
+		 * @param Min - Minimum value (inclusive)
+		 * @param Max - Maximum value (inclusive)
+		 * @return Random integer between Min and Max
+		 */
+		int32 RandInt(const int32 Min, const int32 Max)
+		{
+			if (Max <= Min)
+			{
+				return Min;
+			}
+			// Multiply-shift with rejection of the biased low words (Lemire)
+			const uint64 Range = static_cast<uint64>(static_cast<int64>(Max) - static_cast<int64>(Min)) + 1;
+			if (Range > MAX_uint32)
+			{
+				return static_cast<int32>(RandUInt32());
+			}
+			const uint32 Range32 = static_cast<uint32>(Range);
+			uint64 Product = static_cast<uint64>(RandUInt32()) * Range32;
+			if (static_cast<uint32>(Product) < Range32)
+			{
+				const uint32 Threshold = (0u - Range32) % Range32;
+				while (static_cast<uint32>(Product) < Threshold)
+				{
+					Product = static_cast<uint64>(RandUInt32()) * Range32;
+				}
+			}
+			return static_cast<int32>(static_cast<uint32>(Min) + static_cast<uint32>(Product >> 32));
+		}
+
+		/**
+		 * Generates a random float within the specified range
+		 * @param Min - Minimum value (inclusive)
+		 * @param Max - Maximum value (exclusive)
+		 * @return Random float between Min and Max
+		 */
+		float RandFloat(const float Min = 0.0f, const float Max = 1.0f)
+		{
+			return Min + (Max - Min) * ToUnitFloat(RandUInt32());
+		}
+
+		/**
+		 * Generates a random boolean value with specified probability
+		 * @param Probability - Probability of returning true (0.0 = never, 1.0 = always)
+		 * @return Random boolean value based on probability
+		 */
+		bool RandBool(const float Probability = 0.5f)
+		{
+			return ToUnitFloat(RandUInt32()) < FMath::Clamp(Probability, 0.0f, 1.0f);
+		}
+	};
+
+	/**
+	 * Constructor - Seeds every lane from a root seed
+	 * @param InRootSeed - The seed every lane is derived from
+	 */
+	explicit RandomEngineBank(const int32 InRootSeed)
+	{
+		Seed(InRootSeed);
+	}
+
+	RandomEngineBank(): RandomEngineBank(RandomEngine::StaticNewSeed())
+	{
+	}
+
+	/**
+	 * Re-seeds every lane from a root seed
+	 * @param InRootSeed - The seed every lane is derived from
+	 */
+	void Seed(const int32 InRootSeed)
+	{
+		RootSeed = InRootSeed;
+		for (int32 L = 0; L < LaneCount; ++L)
+		{
+			// Same initialization as std::mt19937(seed)
+			State[0][L] = static_cast<uint32>(RandomEngine::StaticDeriveSeed(RootSeed, static_cast<uint32>(L)));
+			for (int32 i = 1; i < StateSize; ++i)
+			{
+				const uint32 Previous = State[i - 1][L];
+				State[i][L] = 1812433253u * (Previous ^ (Previous >> 30)) + static_cast<uint32>(i);
+			}
+			Cursor[L] = StateSize;
+			GeneratedCount[L] = 0;
+		}
+	}
+
+	/**
+	 * Resets every lane to its initial state with the original root seed
+	 */
+	void Reset()
+	{
+		Seed(RootSeed);
+	}
+
+	int32 GetRootSeed() const { return RootSeed; }
+
+	static constexpr int32 Num() { return LaneCount; }
+
+	/**
+	 * Gets the seed of a lane, a RandomEngine built with it replays the lane's raw sequence
+	 * @param LaneIndex - Lane to query
+	 * @return Seed of the lane
+	 */
+	int32 GetLaneSeed(const int32 LaneIndex) const
+	{
+		return RandomEngine::StaticDeriveSeed(RootSeed, static_cast<uint32>(LaneIndex));
+	}
+
+	/**
+	 * Gets the number of raw values drawn from a lane since initialization
+	 * @param LaneIndex - Lane to query
+	 * @return Raw values drawn from the lane
+	 */
+	uint32 GetLaneState(const int32 LaneIndex) const
+	{
+		return GeneratedCount[LaneIndex];
+	}
+
+	/**
+	 * Gets a handle on one lane
+	 * @param LaneIndex - Lane in [0, LaneCount)
+	 * @return Handle drawing from the lane
+	 */
+	Lane GetLane(const int32 LaneIndex)
+	{
+		check(LaneIndex >= 0 && LaneIndex < LaneCount);
+		return Lane(*this, LaneIndex);
+	}
+
+	/**
+	 * Draws the next raw value of a single lane
+	 * @param LaneIndex - Lane in [0, LaneCount)
+	 * @return Uniform value over the full uint32 range
+	 */
+	uint32 NextLane(const int32 LaneIndex)
+	{
+		if (Cursor[LaneIndex] >= StateSize)
+		{
+			if (IsLockstep())
+			{
+				TwistAll();
+			}
+			else
+			{
+				TwistLane(LaneIndex);
+			}
+		}
+		GeneratedCount[LaneIndex]++;
+		return Temper(State[Cursor[LaneIndex]++][LaneIndex]);
+	}
+
+	/**
+	 * Puts every lane back on the same state word so bulk fills take the vector path again
+	 * Lanes behind the one that drew the most skip ahead to its position: they still follow
+	 * their mt19937 sequence but drop the values in between, so replays must call it at the
+	 * same point
+	 */
+	void Resynchronize()
+	{
+		uint32 Furthest = GeneratedCount[0];
+		for (int32 L = 1; L < LaneCount; ++L)
+		{
+			Furthest = FMath::Max(Furthest, GeneratedCount[L]);
+		}
+		for (int32 L = 0; L < LaneCount; ++L)
+		{
+			while (GeneratedCount[L] < Furthest)
+			{
+				if (Cursor[L] >= StateSize)
+				{
+					TwistLane(L);
+				}
+				const int32 Skipped = static_cast<int32>(FMath::Min<uint32>(Furthest - GeneratedCount[L], StateSize - Cursor[L]));
+				Cursor[L] += Skipped;
+				GeneratedCount[L] += Skipped;
+			}
+		}
+	}
+
+	/**
+	 * Draws raw values from every lane, interleaved
+	 * Falls back to one value at a time while lanes are out of step, see Resynchronize
+	 * OutValues[Row * LaneCount + L] receives the next value of lane L
+	 * @param OutValues - Array to fill, its size must be a multiple of LaneCount
+	 */
+	void FillInterleaved(TArrayView<uint32> OutValues)
+	{
+		check(OutValues.Num() % LaneCount == 0);
+		const int32 RowCount = OutValues.Num() / LaneCount;
+		uint32* RESTRICT Out = OutValues.GetData();
+
+		if (!IsLockstep())
+		{
+			for (int32 Row = 0; Row < RowCount; ++Row)
+			{
+				for (int32 L = 0; L < LaneCount; ++L)
+				{
+					Out[Row * LaneCount + L] = NextLane(L);
+				}
+			}
+			return;
+		}
+
+		int32 Row = 0;
+		while (Row < RowCount)
+		{
+			if (Cursor[0] >= StateSize)
+			{
+				TwistAll();
+			}
+			// Temper whole rows until the block or the output runs out
+			const int32 Rows = FMath::Min(RowCount - Row, StateSize - Cursor[0]);
+			const int32 First = Cursor[0];
+			for (int32 i = 0; i < Rows; ++i)
+			{
+				for (int32 L = 0; L < LaneCount; ++L)
+				{
+					Out[(Row + i) * LaneCount + L] = Temper(State[First + i][L]);
+				}
+			}
+			for (int32 L = 0; L < LaneCount; ++L)
+			{
+				Cursor[L] += Rows;
+				GeneratedCount[L] += Rows;
+			}
+			Row += Rows;
+		}
+	}
+
+	/**
+	 * Draws random floats from every lane, interleaved like FillInterleaved
+	 * @param OutValues - Array to fill, its size must be a multiple of LaneCount
+	 * @param Min - Minimum value (inclusive)
+	 * @param Max - Maximum value (exclusive)
+	 */
+	void FillInterleavedFloat(TArrayView<float> OutValues, const float Min = 0.0f, const float Max = 1.0f)
+	{
+		// Generate in small interleaved chunks so the raw values stay in cache
+		constexpr int32 ChunkSize = 64 * LaneCount;
+		uint32 Raw[ChunkSize];
+		const float Range = Max - Min;
+		for (int32 Start = 0; Start < OutValues.Num(); Start += ChunkSize)
+		{
+			const int32 Count = FMath::Min(ChunkSize, OutValues.Num() - Start);
+			FillInterleaved(TArrayView<uint32>(Raw, Count));
+			for (int32 i = 0; i < Count; ++i)
+			{
+				OutValues[Start + i] = Min + Range * ToUnitFloat(Raw[i]);
+			}
+		}
+	}
+
+	/**
+	 * Maps a raw value to [0, 1) using its 24 high bits, the float mantissa precision
+	 * @param Raw - Raw 32-bit value
+	 * @return Uniform float in [0, 1)
+	 */
+	static FORCEINLINE float ToUnitFloat(const uint32 Raw)
+	{
+		return static_cast<float>(Raw >> 8) * (1.0f / 16777216.0f);
+	}
+};
@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "System/RandomAliasTable.h"
+#include "System/RandomEngine.h"
+
+class UStaticMesh;
+
+/** Vertex color channel used to weight triangles of a RandomMeshSurfaceSampler */
+enum class ERandomMeshWeightChannel : uint8
+{
+	None,
+	Red,
+	Green,
+	Blue,
+	Alpha
+};
+
+/**
+ * RandomMeshSurfaceSampler - Uniform random points on a triangle mesh surface
+ *
+ * Built once from triangle positions: an alias table over the triangle areas picks a triangle
+ * in O(1), then a point is placed in it with folded barycentric coordinates, so every point
+ * costs four raw draws whatever the triangle count. Triangles can also be weighted by a vertex
+ * color channel (painted scatter masks for decals, debris or foliage).
+ *
+ * Points are in the mesh's local space. A built sampler is read-only and can be shared by
+ * several threads, each with its own engine.
+ */
+class MERSENNETWISTERRANDOM_API RandomMeshSurfaceSampler
+{
+public:
+	RandomMeshSurfaceSampler() = default;
+
+	/**
+	 * Builds the sampler from raw mesh buffers
+	 * @param Positions - Vertex positions
+	 * @param Indices - Triangle list, three indices per triangle
+	 * @param VertexColors - Optional vertex colors, one per position, used with WeightChannel
+	 * @param WeightChannel - Color channel scaling the triangle areas (average of the three vertices)
+	 * @return False if the mesh has no triangle with a positive weight
+	 */
+	bool Build(TArrayView<const FVector3f> Positions, TArrayView<const uint32> Indices, TArrayView<const FColor> VertexColors = TArrayView<const FColor>(), const ERandomMeshWeightChannel WeightChannel = ERandomMeshWeightChannel::None);
+
+	/**
+	 * Builds the sampler from a static mesh LOD
+	 * Cooked builds need Allow CPU Access enabled on the mesh to read its buffers.
+	 * @param Mesh - Static mesh to sample
+	 * @param LODIndex - LOD to read
+	 * @param WeightChannel - Vertex color channel scaling the triangle areas
+	 * @return False if the mesh data is not readable or has no triangle with a positive weight
+	 */
+	bool BuildFromStaticMesh(const UStaticMesh& Mesh, const int32 LODIndex = 0, const ERandomMeshWeightChannel WeightChannel = ERandomMeshWeightChannel::None);
+
+	bool IsValid() const { return Triangles.IsValid(); }
+
+	int32 NumTriangles() const { return Origins.Num(); }
+
+	/** Total surface area of the mesh, ignoring color weights */
+	float GetSurfaceArea() const { return SurfaceArea; }
+
+	/**
+	 * Gets the unit normal of a triangle (counter-clockwise winding)
+	 * @param TriangleIndex - Triangle index, as returned by the samplers
+	 * @return Triangle normal
+	 */
+	FVector3f GetTriangleNormal(const int32 TriangleIndex) const { return Normals[TriangleIndex]; }
+
+	/**
+	 * Generates a random point on the surface
+	 * @param Engine - Engine providing the draws
+	 * @param OutTriangleIndex - Optional, receives the triangle the point lies on
+	 * @return Point in mesh space, or zero if the sampler is not built
+	 */
+	FVector RandPoint(RandomEngine& Engine, int32* OutTriangleIndex = nullptr) const;
+
+	/**
+	 * Fills separate X/Y/Z arrays with random points on the surface
+	 * @param Engine - Engine providing the bulk raw draws
+	 * @param OutX - X coordinates, the three arrays must have the same size
+	 * @param OutY - Y coordinates
+	 * @param OutZ - Z coordinates
+	 * @param OutTriangleIndices - Optional, same size, receives the triangle of every point (for normals)
+	 */
+	void RandPoints(RandomEngine& Engine, TArrayView<float> OutX, TArrayView<float> OutY, TArrayView<float> OutZ, TArrayView<int32> OutTriangleIndices = TArrayView<int32>()) const;
+
+	/**
+	 * Fills an array with random points on the surface
+	 * @param Engine - Engine providing the bulk raw draws
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param OutTriangleIndices - Optional, same size, receives the triangle of every point
+	 */
+	void RandPoints(RandomEngine& Engine, TArrayView<FVector> OutPoints, TArrayView<int32> OutTriangleIndices = TArrayView<int32>()) const;
+
+private:
+	/** Per triangle: first vertex and the two edges leaving it */
+	TArray<FVector3f> Origins;
+	TArray<FVector3f> EdgesA;
+	TArray<FVector3f> EdgesB;
+	TArray<FVector3f> Normals;
+
+	/** Picks triangles by weighted area */
+	RandomAliasTable Triangles;
+
+	float SurfaceArea = 0.0f;
+
+	/** Empties the sampler, IsValid is then false */
+	void Clear();
+
+	/** Places a point in a triangle from four raw draws */
+	FORCEINLINE FVector3f PointFromRaw(const uint32 RawIndex, const uint32 RawCoin, const uint32 RawU, const uint32 RawV, int32& OutTriangleIndex) const;
+
+	/** Generates points chunk by chunk and hands each one to a writer */
+	template <typename FWriter>
+	void GeneratePoints(RandomEngine& Engine, const int32 Count, FWriter&& Write) const;
+};
@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "System/RandomEngine.h"
+
+/**
+ * Coherent noise functions provided by RandomNoise
+ * - Perlin: gradient noise on the square / cube lattice (improved Perlin, quintic fade), about [-1, 1]
+ * - Simplex: gradient noise on the simplex lattice, fewer corners and no axis-aligned artifacts, about [-1, 1]
+ * - Value: interpolated random lattice values, cheapest and blockiest, in [-1, 1]
+ * - Worley: cellular noise, distance to the nearest feature point (one per cell), 0 at the points and at most sqrt(D).
+ *   Points are jittered over their whole cell in 2D and 3D; in 4D they stay in the middle third of
+ *   their cell to keep the search at 3^4 cells, which makes the 4D cells noticeably more regular
+ */
+enum class ERandomNoiseType : uint8
+{
+	Perlin,
+	Simplex,
+	Value,
+	Worley
+};
+
+/** Octave settings of fractal (fBm) noise */
+struct RandomNoiseFractal
+{
+	/** Number of summed octaves, in [1, RandomNoise::MaxOctaves] */
+	int32 Octaves = 1;
+
+	/** Frequency multiplier between octaves */
+	float Lacunarity = 2.0f;
+
+	/** Amplitude multiplier between octaves */
+	float Gain = 0.5f;
+};
+
+/**
+ * RandomNoise - Seeded coherent noise for procedural terrain and textures
+ *
+ * The permutation table, the Worley feature points and the per-octave offsets are all drawn
+ * from a RandomEngine, so noise follows the plugin's seeding: the same seed always gives the
+ * same field, on any platform. The lattice repeats every 256 units.
+ *
+ * Sampling is pure, a built noise is read-only and can be evaluated from several threads.
+ * The grid functions fill heightfields and volumes row by row, one octave at a time over the
+ * whole row, and the Parallel variants split the grid into tiles on worker threads with
+ * exactly the same values.
+ */
+class MERSENNETWISTERRANDOM_API RandomNoise
+{
+public:
+	/** Most octaves a fractal sum can use */
+	static constexpr int32 MaxOctaves = 16;
+
+	/** Size of the lattice period and of the permutation table */
+	static constexpr int32 Period = 256;
+
+	/**
+	 * Constructor - Draws the tables from an engine
+	 * @param InType - Noise function to evaluate
+	 * @param Engine - Engine the permutation, feature points and octave offsets are drawn from
+	 */
+	RandomNoise(const ERandomNoiseType InType, RandomEngine& Engine);
+
+	/**
+	 * Constructor - Tables from a seed
+	 * @param InType - Noise function to evaluate
+	 * @param InSeed - Seed of the tables
+	 */
+	RandomNoise(const ERandomNoiseType InType, const int32 InSeed);
+
+	ERandomNoiseType GetType() const { return Type; }
+
+	/**
+	 * Evaluates one octave of noise
+	 * @return Noise value, see ERandomNoiseType for the ranges
+	 */
+	float Sample2D(const double X, const double Y) const;
+
+	float Sample3D(const double X, const double Y, const double Z) const;
+
+	float Sample4D(const double X, const double Y, const double Z, const double W) const;
+
+	/**
+	 * Evaluates fractal noise: octaves at growing frequency and shrinking amplitude, each with its own offset
+	 * The first octave has no offset, so one octave gives the same value as the Sample functions.
+	 * @param Fractal - Octave settings
+	 * @return Weighted average of the octaves, same range as one octave
+	 */
+	float Fbm2D(const double X, const double Y, const RandomNoiseFractal& Fractal) const;
+
+	float Fbm3D(const double X, const double Y, const double Z, const RandomNoiseFractal& Fractal) const;
+
+	float Fbm4D(const double X, const double Y, const double Z, const double W, const RandomNoiseFractal& Fractal) const;
+
+	/**
+	 * Fills a heightfield with fractal noise, row-major (index = Y * Size.X + X)
+	 * @param OutValues - Values to fill, Size.X * Size.Y elements
+	 * @param Size - Number of samples along X and Y
+	 * @param Origin - Noise coordinates of the first sample
+	 * @param Spacing - Distance between samples in noise coordinates (inverse frequency)
+	 * @param Fractal - Octave settings
+	 */
+	void FillGrid2D(TArrayView<float> OutValues, const FIntPoint Size, const FVector2D& Origin, const double Spacing, const RandomNoiseFractal& Fractal = RandomNoiseFractal()) const;
+
+	/**
+	 * Fills a heightfield with fractal noise on all worker threads, same values as FillGrid2D
+	 * @param OutValues - Values to fill, Size.X * Size.Y elements
+	 * @param Size - Number of samples along X and Y
+	 * @param Origin - Noise coordinates of the first sample
+	 * @param Spacing - Distance between samples in noise coordinates
+	 * @param Fractal - Octave settings
+	 */
+	void FillGrid2DParallel(TArrayView<float> OutValues, const FIntPoint Size, const FVector2D& Origin, const double Spacing, const RandomNoiseFractal& Fractal = RandomNoiseFractal()) const;
+
+	/**
+	 * Fills a volume with fractal noise (index = (Z * Size.Y + Y) * Size.X + X)
+	 * @param OutValues - Values to fill, Size.X * Size.Y * Size.Z elements
+	 * @param Size - Number of samples along X, Y and Z
+	 * @param Origin - Noise coordinates of the first sample
+	 * @param Spacing - Distance between samples in noise coordinates
+	 * @param Fractal - Octave settings
+	 */
+	void FillGrid3D(TArrayView<float> OutValues, const FIntVector Size, const FVector& Origin, const double Spacing, const RandomNoiseFractal& Fractal = RandomNoiseFractal()) const;
+
+	/**
+	 * Fills a volume with fractal noise on all worker threads, same values as FillGrid3D
+	 * @param OutValues - Values to fill, Size.X * Size.Y * Size.Z elements
+	 * @param Size - Number of samples along X, Y and Z
+	 * @param Origin - Noise coordinates of the first sample
+	 * @param Spacing - Distance between samples in noise coordinates
+	 * @param Fractal - Octave settings
+	 */
+	void FillGrid3DParallel(TArrayView<float> OutValues, const FIntVector Size, const FVector& Origin, const double Spacing, const RandomNoiseFractal& Fractal = RandomNoiseFractal()) const;
+
+private:
+	ERandomNoiseType Type;
+
+	/** Shuffled 0..255, stored twice so nested lookups never wrap */
+	uint8 Permutation[Period * 2];
+
+	/** Worley feature point of a hashed cell, coordinates in [0, 1) (mapped to the middle third in 4D) */
+	FVector4f FeaturePoints[Period];
+
+	/** Offset added to every octave so their lattices do not line up */
+	FVector4f OctaveOffsets[MaxOctaves];
+
+	/** Draws the tables */
+	void Initialize(RandomEngine& Engine);
+
+	/** Evaluates one octave of the noise function in D dimensions */
+	template <int32 D>
+	float Evaluate(const double (&Coordinates)[D]) const;
+
+	/**
+	 * Evaluates fractal noise on Count samples of a grid row, one octave at a time over the whole row
+	 * @param OutRow - Receives the samples
+	 * @param FirstColumn - Column of the first sample, the row starts at column 0
+	 * @param Count - Number of samples
+	 * @param RowOrigin - Noise coordinates of column 0
+	 * @param Spacing - Distance between columns along X
+	 * @param Fractal - Octave settings
+	 */
+	template <int32 D>
+	void FillRow(float* OutRow, const int32 FirstColumn, const int32 Count, const double (&RowOrigin)[D], const double Spacing, const RandomNoiseFractal& Fractal) const;
+};
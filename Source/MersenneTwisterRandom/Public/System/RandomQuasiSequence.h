@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "System/RandomEngine.h"
+
+/**
+ * Low-discrepancy sequences usable by RandomQuasiSequence
+ * - Sobol: base-2 digital net, Owen scrambled (best 2D/3D uniformity at power-of-two counts)
+ * - Halton: radical inverses in bases 2, 3 and 5, Cranley-Patterson rotated
+ * - R2: additive recurrence on the generalized golden ratio (Roberts), Cranley-Patterson rotated,
+ *   good at any sample count
+ */
+enum class ERandomQuasiSequence : uint8
+{
+	Sobol,
+	Halton,
+	R2
+};
+
+/**
+ * RandomQuasiSequence - Scrambled low-discrepancy point sequence
+ *
+ * Points cover the unit square / cube much more evenly than independent draws, so Monte Carlo
+ * estimates and spawn coverage converge faster. The scrambling is drawn from a RandomEngine:
+ * two sequences with the same seed are identical, different seeds give independent-looking
+ * but equally even sequences.
+ *
+ * Any point is computed from its index in O(1), so a sequence can be shared read-only
+ * between threads, each one reading its own index range.
+ */
+class MERSENNETWISTERRANDOM_API RandomQuasiSequence
+{
+public:
+	/** Number of dimensions the sequences provide */
+	static constexpr int32 MaxDimensions = 3;
+
+	/**
+	 * Constructor - Draws the scrambling from an engine
+	 * @param InType - Sequence to generate
+	 * @param Engine - Engine the scrambling is drawn from (advanced by MaxDimensions draws)
+	 */
+	RandomQuasiSequence(const ERandomQuasiSequence InType, RandomEngine& Engine);
+
+	/**
+	 * Constructor - Scrambling from a seed
+	 * @param InType - Sequence to generate
+	 * @param InSeed - Seed of the scrambling
+	 */
+	RandomQuasiSequence(const ERandomQuasiSequence InType, const int32 InSeed);
+
+	ERandomQuasiSequence GetType() const { return Type; }
+
+	/**
+	 * Gets the point at an index in the unit square
+	 * @param Index - Index of the point in the sequence
+	 * @return Point in [0, 1)^2
+	 */
+	FVector2D GetPoint2D(const uint32 Index) const;
+
+	/**
+	 * Gets the point at an index in the unit cube
+	 * @param Index - Index of the point in the sequence
+	 * @return Point in [0, 1)^3
+	 */
+	FVector GetPoint3D(const uint32 Index) const;
+
+	/**
+	 * Fills an array with consecutive points in the unit square
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param StartIndex - Index of the first point
+	 */
+	void Fill2D(TArrayView<FVector2D> OutPoints, const uint32 StartIndex = 0) const;
+
+	/**
+	 * Fills an array with consecutive points in the unit cube
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param StartIndex - Index of the first point
+	 */
+	void Fill3D(TArrayView<FVector> OutPoints, const uint32 StartIndex = 0) const;
+
+	/**
+	 * Gets one coordinate of a point as a 32-bit fixed-point fraction
+	 * @param Index - Index of the point in the sequence
+	 * @param Dimension - Coordinate, in [0, Dimensions)
+	 * @param Dimensions - 2 or 3, the R2 sequence uses different constants per dimension count
+	 * @return Coordinate scaled by 2^32
+	 */
+	uint32 GetBits(const uint32 Index, const int32 Dimension, const int32 Dimensions) const;
+
+private:
+	ERandomQuasiSequence Type;
+
+	/** Owen scrambling seeds (Sobol) or Cranley-Patterson offsets as 32-bit fractions (Halton, R2) */
+	uint32 Scramble[MaxDimensions];
+};
@@ -0,0 +1,280 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "System/RandomEngine.h"
+
+/**
+ * RandomReservoir - Picks random items from a stream without materializing it
+ *
+ * Items come from a source returning a pointer to the next item (nullptr at the end) or from
+ * an iterator pair, so actor iterators, cursors and generator lambdas can be sampled in one
+ * pass. The reservoir (and the keys of the weighted sampler) live in caller-provided views:
+ * nothing is allocated, and items are only copied when they enter the reservoir.
+ *
+ * - SampleK: Algorithm L (Li, 1994). Draws how many items to skip instead of one value per
+ *   item, so a stream of N items costs O(K * log(N / K)) draws.
+ * - SampleWeightedK: A-ExpJ (Efraimidis & Spirakis, 2006). Same idea for weighted items,
+ *   the weight consumed before the next replacement is drawn as an exponential jump.
+ */
+class RandomReservoir
+{
+	/** Keeps a parameter out of template argument deduction, T is deduced from the reservoir */
+	template <typename T>
+	struct TNonDeduced
+	{
+		using Type = T;
+	};
+
+public:
+	/**
+	 * Picks K items uniformly from a stream (Algorithm L)
+	 * @param Engine - Engine driving the picks
+	 * @param OutReservoir - Receives the picked items, its size is K. Order is arbitrary
+	 * @param Next - Returns the next item, or nullptr at the end of the stream
+	 * @return Number of items written, less than K if the stream was shorter
+	 */
+	template <typename T>
+	static int32 SampleK(RandomEngine& Engine, TArrayView<T> OutReservoir, typename TNonDeduced<TFunctionRef<const T*()>>::Type Next);
+
+	/**
+	 * Picks K items uniformly from an iterator range (Algorithm L)
+	 * Skipped items are stepped over without being copied when the iterator dereferences to a T&,
+	 * iterators returning items by value (TActorIterator) are supported too.
+	 * @param Engine - Engine driving the picks
+	 * @param OutReservoir - Receives the picked items, its size is K. Order is arbitrary
+	 * @param Begin - First iterator
+	 * @param End - End iterator
+	 * @return Number of items written, less than K if the range was shorter
+	 */
+	template <typename T, typename IteratorType>
+	static int32 SampleK(RandomEngine& Engine, TArrayView<T> OutReservoir, IteratorType Begin, IteratorType End);
+
+	/**
+	 * Picks K items from a stream with probability proportional to their weight, without replacement (A-ExpJ)
+	 * Items with a weight <= 0 are never picked.
+	 * @param Engine - Engine driving the picks
+	 * @param OutReservoir - Receives the picked items, its size is K. Order is arbitrary
+	 * @param OutKeys - Scratch space for the reservoir keys, same size as OutReservoir.
+	 * Receives log(U) / Weight of every picked item
+	 * @param Next - Returns the next item, or nullptr at the end of the stream
+	 * @param GetWeight - Returns the weight of an item
+	 * @return Number of items written, less than K if the stream had fewer positive weights
+	 */
+	template <typename T>
+	static int32 SampleWeightedK(RandomEngine& Engine, TArrayView<T> OutReservoir, TArrayView<double> OutKeys, typename TNonDeduced<TFunctionRef<const T*()>>::Type Next, typename TNonDeduced<TFunctionRef<float(const T&)>>::Type GetWeight);
+
+	/**
+	 * Picks K items from an iterator range with probability proportional to their weight (A-ExpJ)
+	 * @param Engine - Engine driving the picks
+	 * @param OutReservoir - Receives the picked items, its size is K. Order is arbitrary
+	 * @param OutKeys - Scratch space for the reservoir keys, same size as OutReservoir
+	 * @param Begin - First iterator
+	 * @param End - End iterator
+	 * @param GetWeight - Returns the weight of an item
+	 * @return Number of items written, less than K if the range had fewer positive weights
+	 */
+	template <typename T, typename IteratorType>
+	static int32 SampleWeightedK(RandomEngine& Engine, TArrayView<T> OutReservoir, TArrayView<double> OutKeys, IteratorType Begin, IteratorType End, typename TNonDeduced<TFunctionRef<float(const T&)>>::Type GetWeight);
+
+private:
+	/**
+	 * Wraps an iterator pair as a stream source
+	 * Iterators dereferencing to a T& are pointed at directly. Others, such as actor iterators
+	 * returning pointers by value, have their current item copied into the source, so the
+	 * returned pointer stays valid until the next call.
+	 */
+	template <typename T, typename IteratorType>
+	static auto MakeIteratorSource(IteratorType Begin, IteratorType End)
+	{
+		using FReference = decltype(*Begin);
+		constexpr bool bReferencesT = std::is_lvalue_reference_v<FReference> && std::is_same_v<std::decay_t<FReference>, T>;
+		return [Begin = MoveTemp(Begin), End = MoveTemp(End), Current = TOptional<T>()]() mutable -> const T*
+		{
+			if (!(Begin != End))
+			{
+				return nullptr;
+			}
+			const T* Item;
+			if constexpr (bReferencesT)
+			{
+				Item = &*Begin;
+			}
+			else
+			{
+				Current.Emplace(*Begin);
+				Item = &Current.GetValue();
+			}
+			++Begin;
+			return Item;
+		};
+	}
+
+	/** Uniform double in (0, 1), safe for logarithms */
+	static FORCEINLINE double OpenUnit(RandomEngine& Engine)
+	{
+		return (static_cast<double>(Engine.RandUInt32()) + 0.5) * (1.0 / 4294967296.0);
+	}
+
+	/** Restores the min-heap on Keys (mirrored on Items) after the key at Index grew */
+	template <typename T>
+	static void SiftDown(TArrayView<T> Items, TArrayView<double> Keys, const int32 Num, int32 Index)
+	{
+		while (true)
+		{
+			const int32 Left = 2 * Index + 1;
+			if (Left >= Num)
+			{
+				return;
+			}
+			const int32 Right = Left + 1;
+			const int32 Child = Right < Num && Keys[Right] < Keys[Left] ? Right : Left;
+			if (Keys[Index] <= Keys[Child])
+			{
+				return;
+			}
+			Swap(Keys[Index], Keys[Child]);
+			Swap(Items[Index], Items[Child]);
+			Index = Child;
+		}
+	}
+
+	/** Restores the min-heap on Keys (mirrored on Items) after inserting at Index */
+	template <typename T>
+	static void SiftUp(TArrayView<T> Items, TArrayView<double> Keys, int32 Index)
+	{
+		while (Index > 0)
+		{
+			const int32 Parent = (Index - 1) / 2;
+			if (Keys[Parent] <= Keys[Index])
+			{
+				return;
+			}
+			Swap(Keys[Index], Keys[Parent]);
+			Swap(Items[Index], Items[Parent]);
+			Index = Parent;
+		}
+	}
+};
+
+template <typename T>
+int32 RandomReservoir::SampleK(RandomEngine& Engine, TArrayView<T> OutReservoir, typename TNonDeduced<TFunctionRef<const T*()>>::Type Next)
+{
+	const int32 K = OutReservoir.Num();
+	if (K == 0)
+	{
+		return 0;
+	}
+
+	for (int32 Count = 0; Count < K; ++Count)
+	{
+		const T* Item = Next();
+		if (Item == nullptr)
+		{
+			return Count;
+		}
+		OutReservoir[Count] = *Item;
+	}
+
+	// W is the largest of K uniform keys; the gap to the next smaller key is geometric
+	double W = FMath::Exp(FMath::Loge(OpenUnit(Engine)) / K);
+	while (true)
+	{
+		const double Skip = FMath::FloorToDouble(FMath::Loge(OpenUnit(Engine)) / FMath::Loge(1.0 - W));
+		for (double Skipped = 0.0; Skipped < Skip; Skipped += 1.0)
+		{
+			if (Next() == nullptr)
+			{
+				return K;
+			}
+		}
+
+		const T* Item = Next();
+		if (Item == nullptr)
+		{
+			return K;
+		}
+		OutReservoir[Engine.RandInt(0, K - 1)] = *Item;
+		W *= FMath::Exp(FMath::Loge(OpenUnit(Engine)) / K);
+	}
+}
+
+template <typename T, typename IteratorType>
+int32 RandomReservoir::SampleK(RandomEngine& Engine, TArrayView<T> OutReservoir, IteratorType Begin, IteratorType End)
+{
+	auto Next = MakeIteratorSource<T>(MoveTemp(Begin), MoveTemp(End));
+	return SampleK<T>(Engine, OutReservoir, Next);
+}
+
+template <typename T>
+int32 RandomReservoir::SampleWeightedK(RandomEngine& Engine, TArrayView<T> OutReservoir, TArrayView<double> OutKeys, typename TNonDeduced<TFunctionRef<const T*()>>::Type Next, typename TNonDeduced<TFunctionRef<float(const T&)>>::Type GetWeight)
+{
+	const int32 K = OutReservoir.Num();
+	if (OutKeys.Num() != K)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomReservoir::SampleWeightedK - OutKeys must have the same size as OutReservoir"));
+		return 0;
+	}
+	if (K == 0)
+	{
+		return 0;
+	}
+
+	// Keys are log(U) / Weight (log of U^(1 / Weight)), the reservoir keeps the K largest in a min-heap
+	int32 Count = 0;
+	while (Count < K)
+	{
+		const T* Item = Next();
+		if (Item == nullptr)
+		{
+			return Count;
+		}
+		const float Weight = GetWeight(*Item);
+		if (!(Weight > 0.0f))
+		{
+			continue;
+		}
+		OutReservoir[Count] = *Item;
+		OutKeys[Count] = FMath::Loge(OpenUnit(Engine)) / Weight;
+		SiftUp(OutReservoir, OutKeys, Count);
+		++Count;
+	}
+
+	while (true)
+	{
+		// Exponential jump: weight to consume before an item beats the smallest key
+		const double MinKey = OutKeys[0];
+		double Jump = FMath::Loge(OpenUnit(Engine)) / MinKey;
+
+		const T* Item = nullptr;
+		float Weight = 0.0f;
+		while (Jump > 0.0)
+		{
+			Item = Next();
+			if (Item == nullptr)
+			{
+				return K;
+			}
+			Weight = GetWeight(*Item);
+			if (Weight > 0.0f)
+			{
+				Jump -= Weight;
+			}
+		}
+
+		// The new key is conditioned to beat the smallest one: U drawn in (MinKey^Weight, 1)
+		const double Threshold = FMath::Exp(MinKey * Weight);
+		const double U = Threshold + (1.0 - Threshold) * OpenUnit(Engine);
+		OutReservoir[0] = *Item;
+		OutKeys[0] = FMath::Loge(U) / Weight;
+		SiftDown(OutReservoir, OutKeys, K, 0);
+	}
+}
+
+template <typename T, typename IteratorType>
+int32 RandomReservoir::SampleWeightedK(RandomEngine& Engine, TArrayView<T> OutReservoir, TArrayView<double> OutKeys, IteratorType Begin, IteratorType End, typename TNonDeduced<TFunctionRef<float(const T&)>>::Type GetWeight)
+{
+	auto Next = MakeIteratorSource<T>(MoveTemp(Begin), MoveTemp(End));
+	return SampleWeightedK<T>(Engine, OutReservoir, OutKeys, Next, GetWeight);
+}
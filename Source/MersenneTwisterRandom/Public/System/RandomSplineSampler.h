@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "System/RandomEngine.h"
+
+class USplineComponent;
+
+/**
+ * RandomSplineSampler - Random positions uniform by distance along a spline
+ *
+ * Drawing the spline input key uniformly crowds points where the tangents are short and
+ * spreads them where they are long. The sampler instead reads the spline once at evenly
+ * spaced distances into a table of locations and rotations, so a random distance maps to
+ * a table slot in O(1) and a sample costs one or two raw draws and an interpolation, with
+ * no spline evaluation.
+ *
+ * Samples can be pushed sideways along the spline's right vector and take the spline's
+ * rotation (X along the tangent). A built sampler is read-only and can be shared by several
+ * threads, each with its own engine.
+ */
+class MERSENNETWISTERRANDOM_API RandomSplineSampler
+{
+public:
+	/** Most table entries a sampler can hold */
+	static constexpr int32 MaxFrames = 1 << 20;
+
+	RandomSplineSampler() = default;
+
+	/**
+	 * Builds the sampler from frames evenly spaced along a path
+	 * @param Locations - Path positions, the first at distance 0 and the last at Length
+	 * @param Rotations - Path rotations (X along the tangent, Y to the right), same size as Locations
+	 * @param Length - Length of the path
+	 * @return False if fewer than two frames are given, the sizes differ or the length is not positive
+	 */
+	bool Build(TArrayView<const FVector> Locations, TArrayView<const FQuat> Rotations, const float Length);
+
+	/**
+	 * Builds the sampler from a spline component
+	 * Distances follow USplineComponent, they are measured on the spline's local points.
+	 * @param Spline - Spline to read
+	 * @param Spacing - Distance between table entries, smaller follows tight bends more closely
+	 * @param bWorldSpace - Whether samples are in world space, otherwise in the component's space
+	 * @return False if the spline has no length
+	 */
+	bool BuildFromSpline(const USplineComponent& Spline, const float Spacing = 25.0f, const bool bWorldSpace = true);
+
+	bool IsValid() const { return Locations.Num() >= 2; }
+
+	float GetLength() const { return Length; }
+
+	/**
+	 * Reads the table at a distance along the path
+	 * @param Distance - Distance from the start, clamped to the path length
+	 * @return Interpolated transform, identity if the sampler is not built
+	 */
+	FTransform GetTransformAtDistance(const float Distance) const;
+
+	/**
+	 * Generates a random position, uniform by distance along the path
+	 * @param Engine - Engine providing the draws
+	 * @param LateralOffset - Largest sideways offset along the right vector, uniform in [-LateralOffset, LateralOffset]
+	 * @param OutDistance - Optional, receives the distance of the sample along the path
+	 * @return Position, or zero if the sampler is not built
+	 */
+	FVector RandLocation(RandomEngine& Engine, const float LateralOffset = 0.0f, float* OutDistance = nullptr) const;
+
+	/**
+	 * Generates a random transform, uniform by distance along the path
+	 * @param Engine - Engine providing the draws
+	 * @param LateralOffset - Largest sideways offset along the right vector
+	 * @param bAlignToTangent - Whether the rotation follows the path, otherwise identity
+	 * @return Transform, or identity if the sampler is not built
+	 */
+	FTransform RandTransform(RandomEngine& Engine, const float LateralOffset = 0.0f, const bool bAlignToTangent = true) const;
+
+	/**
+	 * Fills an array with random positions, uniform by distance along the path
+	 * @param Engine - Engine providing the bulk raw draws
+	 * @param OutLocations - Array to fill, every element is overwritten
+	 * @param LateralOffset - Largest sideways offset along the right vector
+	 * @param OutDistances - Optional, same size, receives the distance of every sample
+	 */
+	void RandLocations(RandomEngine& Engine, TArrayView<FVector> OutLocations, const float LateralOffset = 0.0f, TArrayView<float> OutDistances = TArrayView<float>()) const;
+
+	/**
+	 * Fills an array with random transforms, uniform by distance along the path
+	 * @param Engine - Engine providing the bulk raw draws
+	 * @param OutTransforms - Array to fill, every element is overwritten
+	 * @param LateralOffset - Largest sideways offset along the right vector
+	 * @param bAlignToTangent - Whether the rotations follow the path, otherwise identity
+	 */
+	void RandTransforms(RandomEngine& Engine, TArrayView<FTransform> OutTransforms, const float LateralOffset = 0.0f, const bool bAlignToTangent = true) const;
+
+private:
+	/** Frames at evenly spaced distances, the first at 0 and the last at Length */
+	TArray<FVector> Locations;
+	TArray<FQuat> Rotations;
+
+	float Length = 0.0f;
+
+	/** Interpolates the frames at a fractional table position in [0, Num - 1] */
+	FORCEINLINE void FrameAt(const float Position, FVector& OutLocation, FQuat& OutRotation) const;
+
+	/** Generates samples chunk by chunk and hands each frame, offset and distance to a writer */
+	template <typename FWriter>
+	void GenerateSamples(RandomEngine& Engine, const int32 Count, const float LateralOffset, FWriter&& Write) const;
+};
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "System/RandomEngine.h"
+
+/**
+ * RandomStreamRegistry - A set of named, independent RandomEngine streams
+ *
+ * Every stream is seeded from the registry's root seed and its own name, so the
+ * sequence of one stream never depends on how many values another stream consumed.
+ * Streams live in a contiguous array: names are only looked up once to get an index,
+ * and all further access goes straight to the slot.
+ *
+ * The registry is a plain value type, copying it snapshots every stream state.
+ * Every constructed registry gets its own id, copies keep it, so a handle resolved before
+ * a snapshot stays valid after restoring it, while a handle from another registry is rejected.
+ */
+class MERSENNETWISTERRANDOM_API RandomStreamRegistry
+{
+	/** Identifies the registry in stream handles, unique per constructed registry and shared by its copies */
+	uint32 Id;
+
+	/** The seed every stream is derived from */
+	int32 RootSeed;
+
+	/** Stream engines, indexed by slot */
+	TArray<RandomEngine> Streams;
+
+	/** Stream names, parallel to Streams */
+	TArray<FName> Names;
+
+	/** Name to slot lookup */
+	TMap<FName, int32> Indices;
+
+public:
+	RandomStreamRegistry();
+
+	/**
+	 * Constructor - Initializes the registry with a specific root seed
+	 * @param InRootSeed - The seed every stream is derived from
+	 */
+	RandomStreamRegistry(int32 InRootSeed);
+
+	int32 GetRootSeed() const;
+
+	/**
+	 * Gets the id to store in stream handles next to the slot, never 0
+	 * @return Id of the registry
+	 */
+	uint32 GetId() const;
+
+	/**
+	 * Changes the root seed and re-seeds every stream, existing slots stay valid
+	 * @param InRootSeed - The new root seed
+	 */
+	void SetRootSeed(const int32 InRootSeed);
+
+	/**
+	 * Gets the slot of a named stream, creating the stream if needed
+	 * @param Name - Name of the stream
+	 * @param Backend - Bit generator backend used if the stream is created
+	 * @return Slot of the stream
+	 */
+	int32 FindOrAdd(const FName Name, const ERandomEngineBackend Backend = ERandomEngineBackend::MersenneTwister);
+
+	/**
+	 * Gets the stream in a slot, checking that the handle was resolved on this registry
+	 * @param Index - Slot of the stream
+	 * @param Name - Name the slot is expected to hold
+	 * @param RegistryId - Id of the registry the slot was resolved on
+	 * @return The stream, or nullptr if the handle does not match
+	 */
+	RandomEngine* Find(const int32 Index, const FName Name, const uint32 RegistryId);
+
+	/**
+	 * Gets the stream in a slot without validation
+	 * @param Index - A slot returned by FindOrAdd
+	 * @return The stream
+	 */
+	RandomEngine& Get(const int32 Index);
+
+	/**
+	 * Gets the name of the stream in a slot
+	 * @param Index - A slot returned by FindOrAdd
+	 * @return Name of the stream
+	 */
+	FName GetName(const int32 Index) const;
+
+	/** Number of registered streams */
+	int32 Num() const;
+
+	/**
+	 * Resets every stream to its initial state
+	 */
+	void ResetAll();
+};
@@ -51,6 +51,13 @@ public:
 	 * @param InSeed - The seed value for reproducible random generation
 	 */
 	RandomString(int32 InSeed);
+
+	/**
+	 * Constructor - Initializes the random engine with a specific seed and bit generator backend
+	 * @param InSeed - The seed value for reproducible random generation
+	 * @param InBackend - Bit generator backend of the engine
+	 */
+	RandomString(int32 InSeed, ERandomEngineBackend InBackend);
 	
 	/**
 	 * Destructor
@@ -3,7 +3,149 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
 #include "RandomEngine.h"
+#include "System/RandomAliasTable.h"
+#include "System/RandomNoise.h"
+#include "System/RandomQuasiSequence.h"
+
+class RandomMeshSurfaceSampler;
+class RandomSplineSampler;
+
+/** Direction distribution of the RandomUtility hemisphere samplers */
+enum class ERandomHemisphereLobe : uint8
+{
+	/** Uniform over the hemisphere solid angle */
+	Uniform,
+	/** Cosine-weighted around the normal (diffuse irradiance, ambient occlusion) */
+	Cosine,
+	/** cos^Shape around the axis (Phong specular lobe, Shape is the exponent) */
+	Phong,
+	/** GGX microfacet normals, D(h) * cos(h) (Shape is the GGX alpha, roughness squared) */
+	GGX
+};
+
+/** Volume the positions of RandomUtility::RandTransforms are drawn from */
+enum class ERandomTransformVolume : uint8
+{
+	/** Uniform in Bounds */
+	Box,
+	/** Uniform in the ball of Radius around Center */
+	Sphere,
+	/** Uniform in the horizontal disk of Radius around Center (ground scatter) */
+	Disk
+};
+
+/** Rotations drawn by RandomUtility::RandTransforms */
+enum class ERandomTransformRotation : uint8
+{
+	/** Identity */
+	None,
+	/** Uniform yaw around +Z, instances stay upright */
+	Yaw,
+	/** Uniform over all rotations (SO(3)) */
+	Full
+};
+
+/** Describes the distribution of the transforms generated by RandomUtility::RandTransforms */
+struct RandomTransformSettings
+{
+	ERandomTransformVolume Volume = ERandomTransformVolume::Box;
+
+	/** Position volume for ERandomTransformVolume::Box */
+	FBox Bounds = FBox(FVector(-1.0), FVector(1.0));
+
+	/** Center of the sphere or disk volumes */
+	FVector Center = FVector::ZeroVector;
+
+	/** Radius of the sphere or disk volumes */
+	float Radius = 1.0f;
+
+	ERandomTransformRotation Rotation = ERandomTransformRotation::Full;
+
+	/** Scale range, per axis unless bUniformScale */
+	FVector MinScale = FVector::OneVector;
+	FVector MaxScale = FVector::OneVector;
+
+	/** Whether one factor interpolates all three axes between MinScale and MaxScale */
+	bool bUniformScale = true;
+};
+
+/** Step distribution of the paths generated by RandomUtility::RandWalk */
+enum class ERandomWalk : uint8
+{
+	/** Brownian motion: independent Gaussian steps */
+	Gaussian,
+	/** Levy flight: heavy-tailed step lengths in uniform directions, mostly small steps with rare long jumps */
+	Levy,
+	/** Gaussian steps reflected off per-axis bounds */
+	Bounded,
+	/** Ornstein-Uhlenbeck: Gaussian noise pulled back toward a mean (jitter that does not drift away) */
+	OrnsteinUhlenbeck
+};
+
+/** Describes the paths generated by RandomUtility::RandWalk */
+struct RandomWalkSettings
+{
+	ERandomWalk Type = ERandomWalk::Gaussian;
+
+	/** Standard deviation of a unit-time step (Gaussian, Bounded), scale of the steps (Levy), volatility (OrnsteinUhlenbeck) */
+	float StepSize = 1.0f;
+
+	/** Time between two steps, steps scale with its square root (Levy: with its 1 / LevyAlpha power) */
+	float TimeStep = 1.0f;
+
+	/** Tail index of Levy steps, in [0.1, 1.99]: lower gives longer jumps, close to 2 behaves like Gaussian */
+	float LevyAlpha = 1.5f;
+
+	/** Per-axis bounds of Bounded walks, the 1D and 2D walks use the first components */
+	FVector MinBound = FVector(-1.0);
+	FVector MaxBound = FVector(1.0);
+
+	/** Value OrnsteinUhlenbeck walks revert to, per axis */
+	FVector Mean = FVector::ZeroVector;
+
+	/** Strength of the pull toward Mean, per unit time */
+	float ReversionRate = 1.0f;
+};
+
+/** How RandomUtility::RandPalette draws its colors */
+enum class ERandomPaletteMode : uint8
+{
+	/** Hues stepped by the golden ratio from a random start, evenly spread for any count, random saturation and value */
+	GoldenHue,
+	/** Random hue, saturation and value inside the ranges */
+	HSV,
+	/** Random hue, lightness and chroma in OKLab, where equal distances look equally different */
+	OKLab
+};
+
+/** Describes the palettes generated by RandomUtility::RandPalette */
+struct RandomPaletteSettings
+{
+	ERandomPaletteMode Mode = ERandomPaletteMode::GoldenHue;
+
+	/** HSV saturation and value ranges of GoldenHue and HSV palettes, on sRGB-encoded values */
+	float MinSaturation = 0.5f;
+	float MaxSaturation = 0.9f;
+	float MinValue = 0.75f;
+	float MaxValue = 0.95f;
+
+	/** OKLab lightness and chroma ranges of OKLab palettes, chroma is lowered for colors outside sRGB */
+	float MinLightness = 0.55f;
+	float MaxLightness = 0.85f;
+	float MinChroma = 0.08f;
+	float MaxChroma = 0.18f;
+
+	/**
+	 * Smallest OKLab distance between two colors of the palette, 0 disables the check
+	 * 0.02 is barely noticeable, the default ranges hold about 32 colors at the default distance.
+	 */
+	float MinDistance = 0.06f;
+
+	/** Candidates drawn per color before the one farthest from the others is kept */
+	int32 MaxAttempts = 32;
+};
 
 /**
  * 
@@ -13,6 +155,15 @@ class MERSENNETWISTERRANDOM_API RandomUtility
 	/** The RandomEngine instance used for all random generation */
 	RandomEngine Engine;
 
+	/** Elements per input block of the parallel shuffle, each block has its own substream */
+	static constexpr int32 ParallelShuffleBlockSize = 65536;
+
+	/** Target elements per bucket of the parallel shuffle, small enough to shuffle in cache */
+	static constexpr int32 ParallelShuffleBucketSize = 16384;
+
+	/** Below this size the parallel shuffle runs a plain Fisher-Yates on the calling thread */
+	static constexpr int32 ParallelShuffleMinNum = 2 * ParallelShuffleBlockSize;
+
 public:
 	RandomUtility();
 
@@ -21,6 +172,13 @@ public:
 	 * @param InSeed - The seed value for reproducible random generation
 	 */
 	RandomUtility(int32 InSeed);
+
+	/**
+	 * Constructor - Initializes the random engine with a specific seed and bit generator backend
+	 * @param InSeed - The seed value for reproducible random generation
+	 * @param InBackend - Bit generator backend of the engine
+	 */
+	RandomUtility(int32 InSeed, ERandomEngineBackend InBackend);
 	~RandomUtility();
 
 	/**
@@ -29,10 +187,55 @@ public:
 	 */
 	int32 GetSeed() const;
 
+	/**
+	 * Generates a random opaque color from a single 32-bit draw
+	 * @return Random color with alpha 255
+	 */
 	FColor RandColor();
 
+	/**
+	 * Generates a random color with random alpha from a single 32-bit draw
+	 * @return Random color
+	 */
 	FColor RandColorAlpha();
 
+	/**
+	 * Fills a color buffer (e.g. texture data) with random colors, one 32-bit draw per color
+	 * @param OutColors - Colors to fill, every element is overwritten
+	 * @param bRandomAlpha - Whether alpha is random too, otherwise 255
+	 */
+	void RandColors(TArrayView<FColor> OutColors, const bool bRandomAlpha = false);
+
+	/**
+	 * Fills a large color buffer on all worker threads
+	 * The buffer is split in fixed blocks with their own derived stream, so the result only
+	 * depends on the seed and not on the thread count (but differs from RandColors)
+	 * @param OutColors - Colors to fill, every element is overwritten
+	 * @param bRandomAlpha - Whether alpha is random too, otherwise 255
+	 */
+	void RandColorsParallel(TArrayView<FColor> OutColors, const bool bRandomAlpha = false);
+
+	/* PALETTES */
+
+	/**
+	 * Fills a palette of distinct colors in one call
+	 * Every candidate is checked against the colors already placed through a hash grid in OKLab,
+	 * so the palette costs O(N) distance checks instead of comparing every pair.
+	 * @param OutColors - Linear colors to fill, every element is overwritten, alpha is 1
+	 * @param Settings - Mode, ranges and minimum distance
+	 * @return True if every color is at least MinDistance from the others. Otherwise the colors that
+	 * ran out of attempts are the farthest candidates found, lower MinDistance or widen the ranges.
+	 */
+	bool RandPalette(TArrayView<FLinearColor> OutColors, const RandomPaletteSettings& Settings = RandomPaletteSettings());
+
+	/**
+	 * Fills a palette of distinct sRGB colors in one call, see the FLinearColor overload
+	 * @param OutColors - sRGB colors to fill, every element is overwritten, alpha is 255
+	 * @param Settings - Mode, ranges and minimum distance
+	 * @return True if every color is at least MinDistance from the others
+	 */
+	bool RandPalette(TArrayView<FColor> OutColors, const RandomPaletteSettings& Settings = RandomPaletteSettings());
+
 	FVector RandVector(const float Min, const float Max);
 
 	FVector RandVectorNormalized();
@@ -49,6 +252,46 @@ public:
 
 	FVector RandPointOnSphere(const float Radius = 1.0f);
 
+	/* BATCH SPHERE SAMPLING */
+	// Batch versions draw raw values in bulk and use vectorizable sincos and cube root kernels.
+	// They are much faster for large counts, but produce a different sequence than the scalar calls.
+
+	/**
+	 * Fills separate X/Y/Z arrays with uniform random points inside a sphere
+	 * @param OutX - X coordinates, the three arrays must have the same size
+	 * @param OutY - Y coordinates
+	 * @param OutZ - Z coordinates
+	 * @param Radius - Radius of the sphere
+	 */
+	void RandPointsInSphere(TArrayView<float> OutX, TArrayView<float> OutY, TArrayView<float> OutZ, const float Radius = 1.0f);
+
+	void RandPointsInSphere(TArrayView<double> OutX, TArrayView<double> OutY, TArrayView<double> OutZ, const float Radius = 1.0f);
+
+	/**
+	 * Fills an array with uniform random points inside a sphere
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Radius - Radius of the sphere
+	 */
+	void RandPointsInSphere(TArrayView<FVector> OutPoints, const float Radius = 1.0f);
+
+	/**
+	 * Fills separate X/Y/Z arrays with uniform random points on the surface of a sphere
+	 * @param OutX - X coordinates, the three arrays must have the same size
+	 * @param OutY - Y coordinates
+	 * @param OutZ - Z coordinates
+	 * @param Radius - Radius of the sphere
+	 */
+	void RandPointsOnSphere(TArrayView<float> OutX, TArrayView<float> OutY, TArrayView<float> OutZ, const float Radius = 1.0f);
+
+	void RandPointsOnSphere(TArrayView<double> OutX, TArrayView<double> OutY, TArrayView<double> OutZ, const float Radius = 1.0f);
+
+	/**
+	 * Fills an array with uniform random points on the surface of a sphere
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Radius - Radius of the sphere
+	 */
+	void RandPointsOnSphere(TArrayView<FVector> OutPoints, const float Radius = 1.0f);
+
 	FVector RandPointInCircle(const float Radius = 1.0f);
 
 	FVector RandPointOnCircle(const float Radius = 1.0f);
@@ -57,11 +300,629 @@ public:
 
 	FQuat RandQuat();
 
+	/* TRIG-FREE SAMPLING */
+	// Rejection samplers that avoid sin/cos entirely. Same distributions as the
+	// trigonometric versions above, but a different sequence for the same seed.
+
+	/**
+	 * Generates a uniform random unit vector (Marsaglia rejection, no trigonometry)
+	 * @return Random unit vector
+	 */
+	FVector RandVectorNormalizedRejection();
+
+	/**
+	 * Generates a uniform random 2D unit vector (polar rejection, no trigonometry)
+	 * @return Random 2D unit vector
+	 */
+	FVector2D RandVector2DNormalizedRejection();
+
+	/**
+	 * Generates a uniform random rotation (Marsaglia 4D rejection, no trigonometry)
+	 * @return Random unit quaternion
+	 */
+	FQuat RandQuatRejection();
+
+	/**
+	 * Fills an array with uniform random unit vectors (trig-free, bulk raw draws)
+	 * @param OutVectors - Array to fill, every element is overwritten
+	 */
+	void RandVectorsNormalized(TArrayView<FVector> OutVectors);
+
+	/**
+	 * Fills an array with uniform random 2D unit vectors (trig-free, bulk raw draws)
+	 * @param OutVectors - Array to fill, every element is overwritten
+	 */
+	void RandVectors2DNormalized(TArrayView<FVector2D> OutVectors);
+
+	/**
+	 * Fills an array with uniform random rotations (trig-free, bulk raw draws)
+	 * @param OutQuats - Array to fill, every element is overwritten
+	 */
+	void RandQuats(TArrayView<FQuat> OutQuats);
+
+	/* HEMISPHERE SAMPLING */
+	// Directions around a normal for baking and Monte Carlo integration, drawn directly from the
+	// lobe (no rejection of the lower half of a sphere). Divide by HemisphereDirectionPdf to weight them.
+
+	/**
+	 * Generates a random direction in the hemisphere around a normal
+	 * @param Normal - Axis of the hemisphere (normalized internally). For Phong lobes, usually the reflected direction
+	 * @param Lobe - Direction distribution
+	 * @param Shape - Phong exponent or GGX alpha, ignored by the other lobes
+	 * @return Random unit direction on the normal's side
+	 */
+	FVector RandHemisphereDirection(const FVector& Normal, const ERandomHemisphereLobe Lobe = ERandomHemisphereLobe::Cosine, const float Shape = 0.0f);
+
+	/**
+	 * Fills an array with random directions around a normal (bulk raw draws)
+	 * @param OutDirections - Array to fill, every element is overwritten
+	 * @param Normal - Axis of the hemisphere
+	 * @param Lobe - Direction distribution
+	 * @param Shape - Phong exponent or GGX alpha, ignored by the other lobes
+	 */
+	void RandHemisphereDirections(TArrayView<FVector> OutDirections, const FVector& Normal, const ERandomHemisphereLobe Lobe = ERandomHemisphereLobe::Cosine, const float Shape = 0.0f);
+
+	/**
+	 * Fills separate X/Y/Z arrays with random directions around a normal (bulk raw draws)
+	 * @param OutX - X components, the three arrays must have the same size
+	 * @param OutY - Y components
+	 * @param OutZ - Z components
+	 * @param Normal - Axis of the hemisphere
+	 * @param Lobe - Direction distribution
+	 * @param Shape - Phong exponent or GGX alpha, ignored by the other lobes
+	 */
+	void RandHemisphereDirections(TArrayView<float> OutX, TArrayView<float> OutY, TArrayView<float> OutZ, const FVector& Normal, const ERandomHemisphereLobe Lobe = ERandomHemisphereLobe::Cosine, const float Shape = 0.0f);
+
+	/**
+	 * Gets a point of a quasi-random sequence mapped to a direction around a normal
+	 * @param Sequence - Source sequence
+	 * @param Index - Index of the point in the sequence
+	 * @param Normal - Axis of the hemisphere
+	 * @param Lobe - Direction distribution
+	 * @param Shape - Phong exponent or GGX alpha, ignored by the other lobes
+	 * @return Unit direction on the normal's side
+	 */
+	static FVector QuasiHemisphereDirection(const RandomQuasiSequence& Sequence, const uint32 Index, const FVector& Normal, const ERandomHemisphereLobe Lobe = ERandomHemisphereLobe::Cosine, const float Shape = 0.0f);
+
+	/**
+	 * Fills an array with consecutive quasi-random directions around a normal
+	 * @param OutDirections - Array to fill, every element is overwritten
+	 * @param Sequence - Source sequence
+	 * @param StartIndex - Index of the first point
+	 * @param Normal - Axis of the hemisphere
+	 * @param Lobe - Direction distribution
+	 * @param Shape - Phong exponent or GGX alpha, ignored by the other lobes
+	 */
+	static void QuasiHemisphereDirections(TArrayView<FVector> OutDirections, const RandomQuasiSequence& Sequence, const uint32 StartIndex, const FVector& Normal, const ERandomHemisphereLobe Lobe = ERandomHemisphereLobe::Cosine, const float Shape = 0.0f);
+
+	/**
+	 * Gets the density of a direction under a hemisphere lobe, per unit solid angle
+	 * @param Normal - Axis of the hemisphere
+	 * @param Direction - Unit direction
+	 * @param Lobe - Direction distribution
+	 * @param Shape - Phong exponent or GGX alpha, ignored by the other lobes
+	 * @return Probability density, 0 below the hemisphere
+	 */
+	static float HemisphereDirectionPdf(const FVector& Normal, const FVector& Direction, const ERandomHemisphereLobe Lobe = ERandomHemisphereLobe::Cosine, const float Shape = 0.0f);
+
+	/* SHAPE SAMPLING */
+	// Direct samplers built from inverse CDFs and area-preserving maps, no rejection from a
+	// bounding box. The draws per point depend on the shape: 2 (annulus, spherical cap),
+	// 3 (box volume, capsule surface, cone, spherical sector) or 4 (box surface, capsule
+	// volume). Shapes made of parts spend one of them picking the part by area or volume.
+	// Batch versions draw raw values in bulk and produce a different sequence than the scalar calls.
+
+	/**
+	 * Generates a uniform random point inside an axis-aligned box
+	 * @param Box - The box
+	 * @return Random point in the box
+	 */
+	FVector RandPointInBox(const FBox& Box);
+
+	/**
+	 * Fills an array with uniform random points inside an axis-aligned box
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Box - The box
+	 */
+	void RandPointsInBox(TArrayView<FVector> OutPoints, const FBox& Box);
+
+	/**
+	 * Generates a uniform random point on the surface of an axis-aligned box
+	 * @param Box - The box
+	 * @return Random point on one of the faces, faces are weighted by area
+	 */
+	FVector RandPointOnBox(const FBox& Box);
+
+	/**
+	 * Fills an array with uniform random points on the surface of an axis-aligned box
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Box - The box
+	 */
+	void RandPointsOnBox(TArrayView<FVector> OutPoints, const FBox& Box);
+
+	/**
+	 * Generates a uniform random point inside an oriented box
+	 * @param Box - The box (center, axes and half extents)
+	 * @return Random point in the box
+	 */
+	FVector RandPointInOrientedBox(const FOrientedBox& Box);
+
+	/**
+	 * Fills an array with uniform random points inside an oriented box
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Box - The box (center, axes and half extents)
+	 */
+	void RandPointsInOrientedBox(TArrayView<FVector> OutPoints, const FOrientedBox& Box);
+
+	/**
+	 * Generates a uniform random point on the surface of an oriented box
+	 * @param Box - The box (center, axes and half extents)
+	 * @return Random point on one of the faces, faces are weighted by area
+	 */
+	FVector RandPointOnOrientedBox(const FOrientedBox& Box);
+
+	/**
+	 * Fills an array with uniform random points on the surface of an oriented box
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Box - The box (center, axes and half extents)
+	 */
+	void RandPointsOnOrientedBox(TArrayView<FVector> OutPoints, const FOrientedBox& Box);
+
+	/**
+	 * Generates a uniform random point inside a capsule
+	 * @param Start - Center of the first hemisphere
+	 * @param End - Center of the second hemisphere
+	 * @param Radius - Radius of the capsule
+	 * @return Random point in the capsule
+	 */
+	FVector RandPointInCapsule(const FVector& Start, const FVector& End, const float Radius);
+
+	/**
+	 * Fills an array with uniform random points inside a capsule
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Start - Center of the first hemisphere
+	 * @param End - Center of the second hemisphere
+	 * @param Radius - Radius of the capsule
+	 */
+	void RandPointsInCapsule(TArrayView<FVector> OutPoints, const FVector& Start, const FVector& End, const float Radius);
+
+	/**
+	 * Generates a uniform random point on the surface of a capsule
+	 * @param Start - Center of the first hemisphere
+	 * @param End - Center of the second hemisphere
+	 * @param Radius - Radius of the capsule
+	 * @return Random point on the cylinder or one of the hemispheres, weighted by area
+	 */
+	FVector RandPointOnCapsule(const FVector& Start, const FVector& End, const float Radius);
+
+	/**
+	 * Fills an array with uniform random points on the surface of a capsule
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Start - Center of the first hemisphere
+	 * @param End - Center of the second hemisphere
+	 * @param Radius - Radius of the capsule
+	 */
+	void RandPointsOnCapsule(TArrayView<FVector> OutPoints, const FVector& Start, const FVector& End, const float Radius);
+
+	/**
+	 * Generates a uniform random point inside a solid cone
+	 * @param Apex - Tip of the cone
+	 * @param Direction - Axis from the apex toward the base
+	 * @param Height - Distance from the apex to the base
+	 * @param BaseRadius - Radius of the base disk
+	 * @return Random point in the cone
+	 */
+	FVector RandPointInCone(const FVector& Apex, const FVector& Direction, const float Height, const float BaseRadius);
+
+	/**
+	 * Fills an array with uniform random points inside a solid cone
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Apex - Tip of the cone
+	 * @param Direction - Axis from the apex toward the base
+	 * @param Height - Distance from the apex to the base
+	 * @param BaseRadius - Radius of the base disk
+	 */
+	void RandPointsInCone(TArrayView<FVector> OutPoints, const FVector& Apex, const FVector& Direction, const float Height, const float BaseRadius);
+
+	/**
+	 * Generates a uniform random point on the surface of a cone (lateral surface and base disk)
+	 * @param Apex - Tip of the cone
+	 * @param Direction - Axis from the apex toward the base
+	 * @param Height - Distance from the apex to the base
+	 * @param BaseRadius - Radius of the base disk
+	 * @return Random point on the cone, weighted by area
+	 */
+	FVector RandPointOnCone(const FVector& Apex, const FVector& Direction, const float Height, const float BaseRadius);
+
+	/**
+	 * Fills an array with uniform random points on the surface of a cone (lateral surface and base disk)
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Apex - Tip of the cone
+	 * @param Direction - Axis from the apex toward the base
+	 * @param Height - Distance from the apex to the base
+	 * @param BaseRadius - Radius of the base disk
+	 */
+	void RandPointsOnCone(TArrayView<FVector> OutPoints, const FVector& Apex, const FVector& Direction, const float Height, const float BaseRadius);
+
+	/**
+	 * Generates a uniform random point in a ring
+	 * @param InnerRadius - Radius of the hole
+	 * @param OuterRadius - Outer radius of the ring
+	 * @return Random point in the ring
+	 */
+	FVector2D RandPointInAnnulus(const float InnerRadius, const float OuterRadius);
+
+	/**
+	 * Fills an array with uniform random points in a ring
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param InnerRadius - Radius of the hole
+	 * @param OuterRadius - Outer radius of the ring
+	 */
+	void RandPointsInAnnulus(TArrayView<FVector2D> OutPoints, const float InnerRadius, const float OuterRadius);
+
+	/**
+	 * Generates a uniform random point on a spherical cap (the part of a sphere within a cone)
+	 * @param Direction - Axis of the cap
+	 * @param HalfAngleDegrees - Angle between the axis and the rim of the cap, 180 covers the sphere
+	 * @param Radius - Radius of the sphere
+	 * @return Random point on the cap
+	 */
+	FVector RandPointOnSphericalCap(const FVector& Direction, const float HalfAngleDegrees, const float Radius = 1.0f);
+
+	/**
+	 * Fills an array with uniform random points on a spherical cap (the part of a sphere within a cone)
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Direction - Axis of the cap
+	 * @param HalfAngleDegrees - Angle between the axis and the rim of the cap, 180 covers the sphere
+	 * @param Radius - Radius of the sphere
+	 */
+	void RandPointsOnSphericalCap(TArrayView<FVector> OutPoints, const FVector& Direction, const float HalfAngleDegrees, const float Radius = 1.0f);
+
+	/**
+	 * Generates a uniform random point in a spherical sector (the part of a ball within a cone)
+	 * @param Direction - Axis of the sector
+	 * @param HalfAngleDegrees - Angle between the axis and the rim of the sector
+	 * @param Radius - Radius of the ball
+	 * @return Random point in the sector
+	 */
+	FVector RandPointInSphericalSector(const FVector& Direction, const float HalfAngleDegrees, const float Radius = 1.0f);
+
+	/**
+	 * Fills an array with uniform random points in a spherical sector (the part of a ball within a cone)
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Direction - Axis of the sector
+	 * @param HalfAngleDegrees - Angle between the axis and the rim of the sector
+	 * @param Radius - Radius of the ball
+	 */
+	void RandPointsInSphericalSector(TArrayView<FVector> OutPoints, const FVector& Direction, const float HalfAngleDegrees, const float Radius = 1.0f);
+
+	/* POISSON-DISK SAMPLING */
+	// Bridson's algorithm: blue-noise point sets where no two points are closer than
+	// MinDistance, in O(N) thanks to a background grid. bTiled splits the domain into
+	// tiles filled on worker threads; the result is still deterministic for a seed,
+	// but differs from the single-threaded fill. The grid is capped at 256MB (about 22M
+	// cells in 2D, 16M in 3D); a MinDistance too small for the domain returns no points.
+
+	/**
+	 * Generates Poisson-disk distributed points in a rectangle
+	 * @param Bounds - Rectangle to fill
+	 * @param MinDistance - Minimum distance between two points
+	 * @param MaxAttempts - Candidates tried around a point before giving up on it (30 is the usual value)
+	 * @param bTiled - Fill tiles in parallel, for very large areas
+	 * @return Points in generation order
+	 */
+	TArray<FVector2D> RandPoissonDiskInRect(const FBox2D& Bounds, const float MinDistance, const int32 MaxAttempts = 30, const bool bTiled = false);
+
+	/**
+	 * Generates Poisson-disk distributed points in a circle
+	 * @param Center - Center of the circle
+	 * @param Radius - Radius of the circle
+	 * @param MinDistance - Minimum distance between two points
+	 * @param MaxAttempts - Candidates tried around a point before giving up on it
+	 * @param bTiled - Fill tiles in parallel, for very large areas
+	 * @return Points in generation order
+	 */
+	TArray<FVector2D> RandPoissonDiskInCircle(const FVector2D& Center, const float Radius, const float MinDistance, const int32 MaxAttempts = 30, const bool bTiled = false);
+
+	/**
+	 * Generates Poisson-disk distributed points in a box
+	 * @param Bounds - Box to fill
+	 * @param MinDistance - Minimum distance between two points
+	 * @param MaxAttempts - Candidates tried around a point before giving up on it
+	 * @param bTiled - Fill tiles in parallel, for very large volumes
+	 * @return Points in generation order
+	 */
+	TArray<FVector> RandPoissonDiskInBox(const FBox& Bounds, const float MinDistance, const int32 MaxAttempts = 30, const bool bTiled = false);
+
+	/**
+	 * Generates Poisson-disk distributed points in a sphere
+	 * @param Center - Center of the sphere
+	 * @param Radius - Radius of the sphere
+	 * @param MinDistance - Minimum distance between two points
+	 * @param MaxAttempts - Candidates tried around a point before giving up on it
+	 * @param bTiled - Fill tiles in parallel, for very large volumes
+	 * @return Points in generation order
+	 */
+	TArray<FVector> RandPoissonDiskInSphere(const FVector& Center, const float Radius, const float MinDistance, const int32 MaxAttempts = 30, const bool bTiled = false);
+
+	/* STRATIFIED SAMPLING */
+	// Splits the shape into as many equal-area strata as there are points and jitters one
+	// point in each: N points always cover the whole shape, without clusters or rejection.
+	// Points come out stratum by stratum, shuffle them if the order matters.
+
+	/**
+	 * Fills an array with jittered-grid points in a rectangle
+	 * @param OutPoints - Array to fill, its size is the number of strata
+	 * @param Bounds - Rectangle to fill
+	 */
+	void RandStratifiedInRect(TArrayView<FVector2D> OutPoints, const FBox2D& Bounds);
+
+	/**
+	 * Fills an array with stratified points in a circle (jittered grid through the concentric mapping)
+	 * @param OutPoints - Array to fill, its size is the number of strata
+	 * @param Radius - Radius of the circle
+	 */
+	void RandStratifiedInCircle(TArrayView<FVector2D> OutPoints, const float Radius = 1.0f);
+
+	/**
+	 * Fills an array with stratified points inside a sphere (jittered 3D grid through a volume-preserving mapping)
+	 * @param OutPoints - Array to fill, its size is the number of strata
+	 * @param Radius - Radius of the sphere
+	 */
+	void RandStratifiedInSphere(TArrayView<FVector> OutPoints, const float Radius = 1.0f);
+
+	/**
+	 * Fills an array with stratified points on a sphere surface (jittered grid through an area-preserving mapping)
+	 * @param OutPoints - Array to fill, its size is the number of strata
+	 * @param Radius - Radius of the sphere
+	 */
+	void RandStratifiedOnSphere(TArrayView<FVector> OutPoints, const float Radius = 1.0f);
+
+	/* MESH SURFACE SAMPLING */
+
+	/**
+	 * Generates a uniform random point on a mesh surface
+	 * @param Sampler - Prepared sampler of the mesh
+	 * @param OutTriangleIndex - Optional, receives the triangle the point lies on (for its normal)
+	 * @return Point in mesh space
+	 */
+	FVector RandPointOnMesh(const RandomMeshSurfaceSampler& Sampler, int32* OutTriangleIndex = nullptr);
+
+	/**
+	 * Fills an array with uniform random points on a mesh surface (bulk raw draws)
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Sampler - Prepared sampler of the mesh
+	 * @param OutTriangleIndices - Optional, same size, receives the triangle of every point
+	 */
+	void RandPointsOnMesh(TArrayView<FVector> OutPoints, const RandomMeshSurfaceSampler& Sampler, TArrayView<int32> OutTriangleIndices = TArrayView<int32>());
+
+	/* SPLINE SAMPLING */
+
+	/**
+	 * Generates a random transform uniform by distance along a spline
+	 * @param Sampler - Prepared sampler of the spline
+	 * @param LateralOffset - Largest sideways offset along the spline's right vector
+	 * @param bAlignToTangent - Whether the rotation follows the spline, otherwise identity
+	 * @return Transform in the sampler's space
+	 */
+	FTransform RandTransformOnSpline(const RandomSplineSampler& Sampler, const float LateralOffset = 0.0f, const bool bAlignToTangent = true);
+
+	/**
+	 * Fills an array with random transforms uniform by distance along a spline (bulk raw draws)
+	 * @param OutTransforms - Array to fill, every element is overwritten
+	 * @param Sampler - Prepared sampler of the spline
+	 * @param LateralOffset - Largest sideways offset along the spline's right vector
+	 * @param bAlignToTangent - Whether the rotations follow the spline, otherwise identity
+	 */
+	void RandTransformsOnSpline(TArrayView<FTransform> OutTransforms, const RandomSplineSampler& Sampler, const float LateralOffset = 0.0f, const bool bAlignToTangent = true);
+
+	/**
+	 * Fills an array with random positions uniform by distance along a spline (bulk raw draws)
+	 * @param OutLocations - Array to fill, every element is overwritten
+	 * @param Sampler - Prepared sampler of the spline
+	 * @param LateralOffset - Largest sideways offset along the spline's right vector
+	 */
+	void RandLocationsOnSpline(TArrayView<FVector> OutLocations, const RandomSplineSampler& Sampler, const float LateralOffset = 0.0f);
+
+	/* TRANSFORM GENERATION */
+	// Instance transforms in one pass from bulk raw draws (position, rotation and scale together),
+	// for populating instanced static meshes. Full rotations are uniform over SO(3), unlike RandRotator.
+
+	/**
+	 * Fills an array with random transforms
+	 * @param OutTransforms - Array to fill, every element is overwritten
+	 * @param Settings - Position volume, rotation mode and scale range
+	 */
+	void RandTransforms(TArrayView<FTransform> OutTransforms, const RandomTransformSettings& Settings);
+
+	/**
+	 * Fills separate translation, rotation and scale arrays with random transforms
+	 * @param OutTranslations - Translations, the three arrays must have the same size
+	 * @param OutRotations - Rotations
+	 * @param OutScales - Scales
+	 * @param Settings - Position volume, rotation mode and scale range
+	 */
+	void RandTransforms(TArrayView<FVector> OutTranslations, TArrayView<FQuat> OutRotations, TArrayView<FVector> OutScales, const RandomTransformSettings& Settings);
+
+	/**
+	 * Fills a large transform array on all worker threads
+	 * Blocks of transforms get their own engine derived from this one, so the result only
+	 * depends on the seed and not on the thread count (but differs from RandTransforms)
+	 * @param OutTransforms - Array to fill, every element is overwritten
+	 * @param Settings - Position volume, rotation mode and scale range
+	 */
+	void RandTransformsParallel(TArrayView<FTransform> OutTransforms, const RandomTransformSettings& Settings);
+
+	/**
+	 * Fills large translation, rotation and scale arrays on all worker threads (deterministic, see above)
+	 * @param OutTranslations - Translations, the three arrays must have the same size
+	 * @param OutRotations - Rotations
+	 * @param OutScales - Scales
+	 * @param Settings - Position volume, rotation mode and scale range
+	 */
+	void RandTransformsParallel(TArrayView<FVector> OutTranslations, TArrayView<FQuat> OutRotations, TArrayView<FVector> OutScales, const RandomTransformSettings& Settings);
+
+	/* RANDOM WALKS */
+	// Paths from bulk Gaussian draws: the steps of a chunk are drawn and scaled in one pass,
+	// then accumulated. OutPath[i] is the position after i + 1 steps, Start is not written.
+
+	/**
+	 * Fills an array with the positions of a 1D random walk
+	 * @param OutPath - Positions to fill, one per step
+	 * @param Start - Position before the first step
+	 * @param Settings - Step distribution
+	 */
+	void RandWalk(TArrayView<float> OutPath, const float Start, const RandomWalkSettings& Settings);
+
+	/**
+	 * Fills an array with the positions of a 2D random walk
+	 * @param OutPath - Positions to fill, one per step
+	 * @param Start - Position before the first step
+	 * @param Settings - Step distribution
+	 */
+	void RandWalk(TArrayView<FVector2D> OutPath, const FVector2D& Start, const RandomWalkSettings& Settings);
+
+	/**
+	 * Fills an array with the positions of a 3D random walk
+	 * @param OutPath - Positions to fill, one per step
+	 * @param Start - Position before the first step
+	 * @param Settings - Step distribution
+	 */
+	void RandWalk(TArrayView<FVector> OutPath, const FVector& Start, const RandomWalkSettings& Settings);
+
+	/* LOW-DISCREPANCY SAMPLING */
+	// Shape samplers driven by a scrambled quasi-random sequence instead of independent draws.
+	// They map the sequence through area-preserving transforms (no rejection), so N points
+	// cover the shape evenly and any point is available from its index in O(1).
+
+	/**
+	 * Creates a low-discrepancy sequence scrambled from this utility's engine
+	 * @param Type - Sequence to generate
+	 * @return Sequence, reproducible from the utility's seed
+	 */
+	RandomQuasiSequence MakeQuasiSequence(const ERandomQuasiSequence Type = ERandomQuasiSequence::Sobol);
+
+	/**
+	 * Creates a coherent noise whose tables are drawn from this utility's engine
+	 * @param Type - Noise function to evaluate
+	 * @return Noise, reproducible from the utility's seed
+	 */
+	RandomNoise MakeNoise(const ERandomNoiseType Type = ERandomNoiseType::Perlin);
+
+	/**
+	 * Gets a point of a quasi-random sequence mapped into a circle
+	 * @param Sequence - Source sequence
+	 * @param Index - Index of the point in the sequence
+	 * @param Radius - Radius of the circle
+	 * @return Point in the circle
+	 */
+	static FVector2D QuasiPointInCircle(const RandomQuasiSequence& Sequence, const uint32 Index, const float Radius = 1.0f);
+
+	/**
+	 * Gets a point of a quasi-random sequence mapped into a sphere
+	 * @param Sequence - Source sequence
+	 * @param Index - Index of the point in the sequence
+	 * @param Radius - Radius of the sphere
+	 * @return Point in the sphere
+	 */
+	static FVector QuasiPointInSphere(const RandomQuasiSequence& Sequence, const uint32 Index, const float Radius = 1.0f);
+
+	/**
+	 * Gets a point of a quasi-random sequence mapped onto a sphere surface
+	 * @param Sequence - Source sequence
+	 * @param Index - Index of the point in the sequence
+	 * @param Radius - Radius of the sphere
+	 * @return Point on the sphere
+	 */
+	static FVector QuasiPointOnSphere(const RandomQuasiSequence& Sequence, const uint32 Index, const float Radius = 1.0f);
+
+	/**
+	 * Fills an array with consecutive quasi-random points in a circle
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Sequence - Source sequence
+	 * @param StartIndex - Index of the first point
+	 * @param Radius - Radius of the circle
+	 */
+	static void QuasiPointsInCircle(TArrayView<FVector2D> OutPoints, const RandomQuasiSequence& Sequence, const uint32 StartIndex = 0, const float Radius = 1.0f);
+
+	/**
+	 * Fills an array with consecutive quasi-random points in a sphere
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Sequence - Source sequence
+	 * @param StartIndex - Index of the first point
+	 * @param Radius - Radius of the sphere
+	 */
+	static void QuasiPointsInSphere(TArrayView<FVector> OutPoints, const RandomQuasiSequence& Sequence, const uint32 StartIndex = 0, const float Radius = 1.0f);
+
+	/**
+	 * Fills an array with consecutive quasi-random points on a sphere surface
+	 * @param OutPoints - Array to fill, every element is overwritten
+	 * @param Sequence - Source sequence
+	 * @param StartIndex - Index of the first point
+	 * @param Radius - Radius of the sphere
+	 */
+	static void QuasiPointsOnSphere(TArrayView<FVector> OutPoints, const RandomQuasiSequence& Sequence, const uint32 StartIndex = 0, const float Radius = 1.0f);
+
+	/**
+	 * Returns a random element of an array, without copying it
+	 * @param Array - The array to select from
+	 * @return Pointer to a random element, or nullptr if the array is empty
+	 */
 	template <typename T>
-	T RandArrayElement(const TArray<T>& Array);
+	T* RandArrayElement(TArrayView<T> Array);
+
+	template <typename T, typename AllocatorType>
+	T* RandArrayElement(TArray<T, AllocatorType>& Array);
+
+	template <typename T, typename AllocatorType>
+	const T* RandArrayElement(const TArray<T, AllocatorType>& Array);
 
+	/**
+	 * Returns a random element of an array, picked with probability proportional to its weight
+	 * The weights are read through a projection in two passes, no weight array is built. For
+	 * repeated picks from the same array, use the overload taking a RandomAliasTableCache.
+	 * @param Array - The array to select from
+	 * @param GetWeight - Projection float(const T&) returning the weight of an element, must give the
+	 * same value on both passes. Entries <= 0 are never picked
+	 * @return Pointer to the picked element, or nullptr if no weight is positive
+	 */
+	template <typename T, typename FProjection>
+	T* RandArrayElementWeighted(TArrayView<T> Array, FProjection&& GetWeight);
+
+	template <typename T, typename AllocatorType, typename FProjection>
+	T* RandArrayElementWeighted(TArray<T, AllocatorType>& Array, FProjection&& GetWeight);
+
+	template <typename T, typename AllocatorType, typename FProjection>
+	const T* RandArrayElementWeighted(const TArray<T, AllocatorType>& Array, FProjection&& GetWeight);
+
+	/**
+	 * Returns a random weighted element of an array through a cached alias table, O(1) per pick
+	 * The weights are only read again when Version or the array size differs from the last call
+	 * with the same cache.
+	 * @param Array - The array to select from
+	 * @param Cache - Cache kept next to the array
+	 * @param Version - The owner's version of the array, bump it whenever elements or weights change
+	 * @param GetWeight - Projection float(const T&) returning the weight of an element, entries <= 0 are never picked
+	 * @return Pointer to the picked element, or nullptr if no weight is positive
+	 */
+	template <typename T, typename FProjection>
+	T* RandArrayElementWeighted(TArrayView<T> Array, RandomAliasTableCache& Cache, const uint32 Version, FProjection&& GetWeight);
+
+	template <typename T, typename AllocatorType, typename FProjection>
+	T* RandArrayElementWeighted(TArray<T, AllocatorType>& Array, RandomAliasTableCache& Cache, const uint32 Version, FProjection&& GetWeight);
+
+	template <typename T, typename AllocatorType, typename FProjection>
+	const T* RandArrayElementWeighted(const TArray<T, AllocatorType>& Array, RandomAliasTableCache& Cache, const uint32 Version, FProjection&& GetWeight);
+
+	/**
+	 * Shuffles an array in place using Fisher-Yates algorithm, elements are swapped by move
+	 * @param Array - The array to shuffle
+	 */
 	template <typename T>
-	void ShuffleArray(TArray<T>& Array);
+	void ShuffleArray(TArrayView<T> Array);
+
+	template <typename T, typename AllocatorType>
+	void ShuffleArray(TArray<T, AllocatorType>& Array);
 
 	/**
 	 * Returns a random UObject* element from an array
@@ -76,9 +937,345 @@ public:
 	 */
 	void ShuffleArrayObject(TArray<UObject*>& Array);
 
+	/**
+	 * Shuffles a large array on all worker threads (bucket-then-shuffle)
+	 * Every element is sent to a random bucket, then each bucket is shuffled on its own. Blocks
+	 * and buckets draw from substreams derived from this utility's engine, so the permutation
+	 * only depends on the seed, not on the thread count (but differs from ShuffleArray).
+	 * @param Array - The array to shuffle, elements are moved, never copied
+	 */
+	template <typename T>
+	void ShuffleArrayParallel(TArrayView<T> Array);
+
+	template <typename T, typename AllocatorType>
+	void ShuffleArrayParallel(TArray<T, AllocatorType>& Array);
+
+	/* SAMPLING WITHOUT REPLACEMENT */
+	// Sparse partial Fisher-Yates: K distinct picks cost O(K) time and memory whatever the
+	// size of the range, instead of copying and shuffling the whole array.
+
+	/**
+	 * Fills an array with distinct random integers in [Min, Max], in random order
+	 * @param OutIndices - Array to fill, its size is the number of picks K. If K exceeds the range
+	 * size, the whole range is returned and the remaining elements are set to INDEX_NONE
+	 * @param Min - Lower bound (inclusive)
+	 * @param Max - Upper bound (inclusive)
+	 */
+	void RandIndicesK(TArrayView<int32> OutIndices, const int32 Min, const int32 Max);
+
+	/**
+	 * Picks K distinct random indices in [0, Num), in random order
+	 * @param K - Number of picks, clamped to Num
+	 * @param Num - Size of the index range
+	 * @return Picked indices
+	 */
+	TArray<int32> RandIndicesK(const int32 K, const int32 Num);
+
+	/**
+	 * Picks K distinct random elements of an array (by position), in random order
+	 * @param Array - The array to sample from
+	 * @param K - Number of picks, clamped to the array size
+	 * @return Copies of the picked elements
+	 */
+	template <typename T>
+	TArray<std::remove_const_t<T>> RandSampleK(TArrayView<T> Array, const int32 K);
+
+	template <typename T, typename AllocatorType>
+	TArray<T> RandSampleK(const TArray<T, AllocatorType>& Array, const int32 K);
+
+	/**
+	 * Gets the curve value at a uniform random time between the first and last key
+	 * @param Curve - Inline curve or external curve asset
+	 * @return Curve value, or 0 if the curve has no keys
+	 */
 	float RandCurveValue(const FRuntimeFloatCurve& Curve);
 
+	/**
+	 * Gets the curve value at a uniform random time between the first and last key
+	 * @param Curve - Curve asset, evaluated exactly
+	 * @return Curve value, or 0 if the curve has no keys
+	 */
 	float RandCurveAsset(const UCurveFloat& Curve);
 
+	/**
+	 * Gets the curve value at a uniform random time from the asset's cached RandomCurveSampler
+	 * Faster than RandCurveAsset for curves with many keys, but reads a linearly interpolated
+	 * table: next to steps (constant keys) it can return values between the two levels, and it
+	 * produces a different sequence for the same seed.
+	 * @param Curve - Curve asset
+	 * @return Curve value, or 0 if the curve has no keys
+	 */
+	float RandCurveAssetCached(const UCurveFloat& Curve);
+
+	/**
+	 * Fills an array with curve values at uniform random times, from the asset's cached sampler
+	 * Same table as RandCurveAssetCached.
+	 * @param Curve - Curve asset
+	 * @param OutValues - Array to fill, every element is overwritten
+	 */
+	void RandCurveAssetValues(const UCurveFloat& Curve, TArrayView<float> OutValues);
+
+	/**
+	 * Gets a random time distributed like the curve values, negative values count as zero
+	 * @param Curve - Curve asset, used as a density over time
+	 * @return Time between the first and last key, or the first key time if the curve has no positive area
+	 */
+	float RandCurveAssetTime(const UCurveFloat& Curve);
+
+	/**
+	 * Fills an array with random times distributed like the curve values
+	 * @param Curve - Curve asset, used as a density over time
+	 * @param OutTimes - Array to fill, every element is overwritten
+	 */
+	void RandCurveAssetTimes(const UCurveFloat& Curve, TArrayView<float> OutTimes);
+
 	float RandCurveRange(const FRuntimeFloatCurve& Curve, const float Min, const float Max);
 };
+
+template <typename T>
+T* RandomUtility::RandArrayElement(TArrayView<T> Array)
+{
+	if (Array.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::RandArrayElement - Array is empty"));
+		return nullptr;
+	}
+
+	const int32 RandomIndex = Engine.RandInt(0, Array.Num() - 1);
+	return &Array[RandomIndex];
+}
+
+template <typename T, typename AllocatorType>
+T* RandomUtility::RandArrayElement(TArray<T, AllocatorType>& Array)
+{
+	return RandArrayElement(MakeArrayView(Array));
+}
+
+template <typename T, typename AllocatorType>
+const T* RandomUtility::RandArrayElement(const TArray<T, AllocatorType>& Array)
+{
+	return RandArrayElement(MakeArrayView(Array));
+}
+
+template <typename T, typename FProjection>
+T* RandomUtility::RandArrayElementWeighted(TArrayView<T> Array, FProjection&& GetWeight)
+{
+	double TotalWeight = 0.0;
+	for (const T& Element : Array)
+	{
+		const float Weight = GetWeight(Element);
+		if (Weight > 0.0f)
+		{
+			TotalWeight += Weight;
+		}
+	}
+	if (TotalWeight <= 0.0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::RandArrayElementWeighted - Array has no element with a positive weight"));
+		return nullptr;
+	}
+
+	// Second pass finds the element whose weight range holds the draw
+	const double Target = TotalWeight * (Engine.RandUInt32() * (1.0 / 4294967296.0));
+	double Cumulative = 0.0;
+	int32 LastPicked = INDEX_NONE;
+	for (int32 i = 0; i < Array.Num(); ++i)
+	{
+		const float Weight = GetWeight(Array[i]);
+		if (Weight > 0.0f)
+		{
+			Cumulative += Weight;
+			LastPicked = i;
+			if (Target < Cumulative)
+			{
+				return &Array[i];
+			}
+		}
+	}
+
+	// Rounding can leave the draw just past the sum, it belongs to the last positive weight
+	return &Array[LastPicked];
+}
+
+template <typename T, typename AllocatorType, typename FProjection>
+T* RandomUtility::RandArrayElementWeighted(TArray<T, AllocatorType>& Array, FProjection&& GetWeight)
+{
+	return RandArrayElementWeighted(MakeArrayView(Array), Forward<FProjection>(GetWeight));
+}
+
+template <typename T, typename AllocatorType, typename FProjection>
+const T* RandomUtility::RandArrayElementWeighted(const TArray<T, AllocatorType>& Array, FProjection&& GetWeight)
+{
+	return RandArrayElementWeighted(MakeArrayView(Array), Forward<FProjection>(GetWeight));
+}
+
+template <typename T, typename FProjection>
+T* RandomUtility::RandArrayElementWeighted(TArrayView<T> Array, RandomAliasTableCache& Cache, const uint32 Version, FProjection&& GetWeight)
+{
+	const RandomAliasTable& Table = Cache.Prepare(Array, Version, Forward<FProjection>(GetWeight));
+	if (!Table.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RandomUtility::RandArrayElementWeighted - Array has no element with a positive weight"));
+		return nullptr;
+	}
+	return &Array[Table.Sample(Engine)];
+}
+
+template <typename T, typename AllocatorType, typename FProjection>
+T* RandomUtility::RandArrayElementWeighted(TArray<T, AllocatorType>& Array, RandomAliasTableCache& Cache, const uint32 Version, FProjection&& GetWeight)
+{
+	return RandArrayElementWeighted(MakeArrayView(Array), Cache, Version, Forward<FProjection>(GetWeight));
+}
+
+template <typename T, typename AllocatorType, typename FProjection>
+const T* RandomUtility::RandArrayElementWeighted(const TArray<T, AllocatorType>& Array, RandomAliasTableCache& Cache, const uint32 Version, FProjection&& GetWeight)
+{
+	return RandArrayElementWeighted(MakeArrayView(Array), Cache, Version, Forward<FProjection>(GetWeight));
+}
+
+template <typename T>
+void RandomUtility::ShuffleArray(TArrayView<T> Array)
+{
+	// Fisher-Yates shuffle algorithm
+	for (int32 i = Array.Num() - 1; i > 0; --i)
+	{
+		const int32 j = Engine.RandInt(0, i);
+		if (i != j)
+		{
+			Swap(Array[i], Array[j]);
+		}
+	}
+}
+
+template <typename T, typename AllocatorType>
+void RandomUtility::ShuffleArray(TArray<T, AllocatorType>& Array)
+{
+	ShuffleArray(MakeArrayView(Array));
+}
+
+template <typename T>
+TArray<std::remove_const_t<T>> RandomUtility::RandSampleK(TArrayView<T> Array, const int32 K)
+{
+	const TArray<int32> Indices = RandIndicesK(FMath::Min(K, Array.Num()), Array.Num());
+	TArray<std::remove_const_t<T>> Sample;
+	Sample.Reserve(Indices.Num());
+	for (const int32 Index : Indices)
+	{
+		Sample.Add(Array[Index]);
+	}
+	return Sample;
+}
+
+template <typename T, typename AllocatorType>
+TArray<T> RandomUtility::RandSampleK(const TArray<T, AllocatorType>& Array, const int32 K)
+{
+	return RandSampleK(MakeArrayView(Array), K);
+}
+
+template <typename T>
+void RandomUtility::ShuffleArrayParallel(TArrayView<T> Array)
+{
+	const int32 Num = Array.Num();
+	if (Num < ParallelShuffleMinNum)
+	{
+		ShuffleArray(Array);
+		return;
+	}
+
+	// Power-of-two bucket count: a bucket is the top bits of one raw draw, exactly uniform
+	const int32 BucketBits = FMath::Clamp(static_cast<int32>(FMath::CeilLogTwo(static_cast<uint32>(Num / ParallelShuffleBucketSize))), 1, 16);
+	const int32 BucketCount = 1 << BucketBits;
+	const int32 BlockCount = FMath::DivideAndRoundUp(Num, ParallelShuffleBlockSize);
+	const int32 BaseSeed = static_cast<int32>(Engine.RandUInt32());
+	const ERandomEngineBackend Backend = Engine.GetBackend();
+
+	// Replays the bucket draws of a block, so the counting and scattering passes agree without storing them
+	auto ForEachBucketDraw = [&](const int32 Block, auto&& Visit)
+	{
+		RandomEngine BlockEngine(RandomEngine::StaticDeriveSeed(BaseSeed, static_cast<uint32>(Block)), Backend);
+		const int32 Start = Block * ParallelShuffleBlockSize;
+		const int32 Count = FMath::Min(ParallelShuffleBlockSize, Num - Start);
+		constexpr int32 ChunkSize = 256;
+		uint32 Raw[ChunkSize];
+		for (int32 Offset = 0; Offset < Count; Offset += ChunkSize)
+		{
+			const int32 ChunkCount = FMath::Min(ChunkSize, Count - Offset);
+			BlockEngine.RandUInt32s(TArrayView<uint32>(Raw, ChunkCount));
+			for (int32 k = 0; k < ChunkCount; ++k)
+			{
+				Visit(Start + Offset + k, Raw[k] >> (32 - BucketBits));
+			}
+		}
+	};
+
+	// Count elements per block and bucket, one row per block. Rows are padded to whole cache lines
+	// and the table is line aligned, so threads never share a line even with few buckets
+	const int32 RowStride = Align(BucketCount, PLATFORM_CACHE_LINE_SIZE / static_cast<int32>(sizeof(int32)));
+	TArray<int32, TAlignedHeapAllocator<PLATFORM_CACHE_LINE_SIZE>> Cursors;
+	Cursors.SetNumZeroed(BlockCount * RowStride);
+	ParallelFor(BlockCount, [&](const int32 Block)
+	{
+		int32* BlockCounts = &Cursors[Block * RowStride];
+		ForEachBucketDraw(Block, [BlockCounts](const int32, const uint32 Bucket)
+		{
+			++BlockCounts[Bucket];
+		});
+	});
+
+	// Bucket-major exclusive prefix sum: within a bucket, blocks write in block order
+	TArray<int32> BucketStarts;
+	BucketStarts.SetNumUninitialized(BucketCount + 1);
+	int32 Running = 0;
+	for (int32 Bucket = 0; Bucket < BucketCount; ++Bucket)
+	{
+		BucketStarts[Bucket] = Running;
+		for (int32 Block = 0; Block < BlockCount; ++Block)
+		{
+			int32& Cursor = Cursors[Block * RowStride + Bucket];
+			const int32 Count = Cursor;
+			Cursor = Running;
+			Running += Count;
+		}
+	}
+	BucketStarts[BucketCount] = Num;
+
+	// Scatter: every slot of Scattered is move-constructed exactly once
+	TArray<T> Scattered;
+	Scattered.SetNumUninitialized(Num);
+	T* ScatteredData = Scattered.GetData();
+	ParallelFor(BlockCount, [&](const int32 Block)
+	{
+		int32* BlockCursors = &Cursors[Block * RowStride];
+		ForEachBucketDraw(Block, [&](const int32 Index, const uint32 Bucket)
+		{
+			new (ScatteredData + BlockCursors[Bucket]++) T(MoveTemp(Array[Index]));
+		});
+	});
+
+	// Shuffle each bucket in cache and move it back in place
+	ParallelFor(BucketCount, [&](const int32 Bucket)
+	{
+		RandomEngine BucketEngine(RandomEngine::StaticDeriveSeed(BaseSeed, static_cast<uint32>(BlockCount + Bucket)), Backend);
+		const int32 Start = BucketStarts[Bucket];
+		const int32 Count = BucketStarts[Bucket + 1] - Start;
+		T* Data = ScatteredData + Start;
+		for (int32 i = Count - 1; i > 0; --i)
+		{
+			const int32 j = BucketEngine.RandInt(0, i);
+			if (i != j)
+			{
+				Swap(Data[i], Data[j]);
+			}
+		}
+		for (int32 i = 0; i < Count; ++i)
+		{
+			Array[Start + i] = MoveTemp(Data[i]);
+		}
+	});
+}
+
+template <typename T, typename AllocatorType>
+void RandomUtility::ShuffleArrayParallel(TArray<T, AllocatorType>& Array)
+{
+	ShuffleArrayParallel(MakeArrayView(Array));
+}
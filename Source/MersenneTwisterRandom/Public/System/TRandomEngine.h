@@ -0,0 +1,268 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include <random>
+#include "CoreMinimal.h"
+#include "System/RandomBitGenerators.h"
+#include "System/RandomEngine.h"
+
+/**
+ * TRandomEngine - Engine with its bit generator fixed at compile time
+ *
+ * RandomEngine selects its backend at runtime, so every instance carries storage for the
+ * largest backend (Mersenne Twister, 2.5KB) and every draw goes through a switch. This engine
+ * holds only the generator it is instantiated with: TRandomEngine<PCG64> is 24 bytes (16 of
+ * state, plus the seed and the state counter), TRandomEngine<Xoshiro256PlusPlus> is 40 bytes,
+ * and draws inline straight into the generator.
+ *
+ * Seeded with the same value, it produces the values of a RandomEngine using the matching
+ * backend, and its state counter follows the same rules, so a saved GetCurrentState can be
+ * replayed on either. It covers the core generation functions only; RandomUtility and
+ * RandomString still take a RandomEngine.
+ *
+ * @tparam FBitGenerator - SFMT19937, PCG64, Xoshiro256PlusPlus or std::mt19937
+ */
+template <typename FBitGenerator>
+class TRandomEngine
+{
+	/**
+	 * Presents the generator as a 32-bit generator (64-bit generators return their high word),
+	 * so std distributions consume the same draws as they do through RandomBitGenerator
+	 */
+	struct FGenerator32
+	{
+		using result_type = uint32;
+
+		FBitGenerator Inner;
+
+		explicit FGenerator32(const uint32 InSeed): Inner(InSeed)
+		{
+		}
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return MAX_uint32; }
+
+		FORCEINLINE result_type operator()()
+		{
+			if constexpr (FBitGenerator::max() > MAX_uint32)
+			{
+				return static_cast<uint32>(Inner() >> 32);
+			}
+			else
+			{
+				return static_cast<uint32>(Inner());
+			}
+		}
+	};
+
+	/** The seed used to initialize the random generator */
+	int32 Seed;
+
+	/** Number of values generated since initialization */
+	uint32 GeneratedCount;
+
+	FGenerator32 Generator;
+
+public:
+	TRandomEngine(): TRandomEngine(RandomEngine::StaticNewSeed())
+	{
+	}
+
+	/**
+	 * Constructor - Initializes the random engine with a specific seed
+	 * @param InSeed - The seed value for reproducible random generation
+	 */
+	explicit TRandomEngine(const int32 InSeed):
+		Seed(InSeed), GeneratedCount(0), Generator(static_cast<uint32>(InSeed))
+	{
+	}
+
+	int32 GetRootSeed() const { return Seed; }
+
+	/**
+	 * Generates a random integer within the specified range (inclusive)
+	 * @param Min - Minimum value (inclusive), defaults to 0
+	 * @param Max - Maximum value (inclusive), defaults to 1000
+	 * @return Random integer between Min and Max
+	 */
+	int32 RandInt(const int32 Min = 0, const int32 Max = 1000);
+
+	/**
+	 * Generates a raw 32-bit value straight from the generator
+	 * @return Uniform value over the full uint32 range
+	 */
+	FORCEINLINE uint32 RandUInt32()
+	{
+		GeneratedCount++;
+		return Generator();
+	}
+
+	/**
+	 * Fills an array with raw 32-bit values
+	 * @param OutValues - Array to fill, every element is overwritten
+	 */
+	void RandUInt32s(TArrayView<uint32> OutValues);
+
+	/**
+	 * Generates a random float within the specified range (inclusive)
+	 * @param Min - Minimum value (inclusive), defaults to 0.0f
+	 * @param Max - Maximum value (inclusive), defaults to 1.0f
+	 * @return Random float between Min and Max
+	 */
+	float RandFloat(const float Min = 0.0f, const float Max = 1.0f);
+
+	/**
+	 * Fills an array with uniform floats, one raw draw per value
+	 * Same values as RandomEngine::RandFloats for the same state.
+	 * @param OutValues - Array to fill, every element is overwritten
+	 * @param Min - Minimum value (inclusive), defaults to 0.0f
+	 * @param Max - Maximum value (exclusive), defaults to 1.0f
+	 */
+	void RandFloats(TArrayView<float> OutValues, const float Min = 0.0f, const float Max = 1.0f);
+
+	/**
+	 * Generates a random boolean value (true/false) with specified probability
+	 * @param Probability - Probability of returning true (0.0 = never, 1.0 = always, 0.5 = 50/50)
+	 * @return Random boolean value based on probability
+	 */
+	bool RandBool(const float Probability = 0.5f);
+
+	/**
+	 * Bell curve distribution (most values near center)
+	 * @param Mean - Mean of the distribution
+	 * @param StdDev - Standard deviation of the distribution
+	 * @return Random float from the distribution
+	 */
+	float RandGaussian(const float Mean = 0.0f, const float StdDev = 1.0f);
+
+	/**
+	 * Discards the next N random numbers from the generator
+	 * @param Count - Number of random values to discard
+	 */
+	void Discard(const uint32 Count);
+
+	/**
+	 * Discards random numbers until reaching a specific state
+	 * @param TargetState - The target state to jump to
+	 */
+	void JumpToState(const uint32 TargetState);
+
+	/**
+	 * Gets the current state of the generator
+	 * @return Current state value
+	 */
+	uint32 GetCurrentState() const { return GeneratedCount; }
+
+	/** Resets the generator to its initial state with the original seed */
+	void Reset();
+
+	/**
+	 * Advances the generator by a specific number of steps
+	 * @param Steps - Number of steps to advance
+	 */
+	void Advance(const uint32 Steps);
+};
+
+/** Engines for the fixed backends, see ERandomEngineBackend for their trade-offs */
+using RandomEngineMT = TRandomEngine<std::mt19937>;
+using RandomEngineSFMT = TRandomEngine<SFMT19937>;
+using RandomEnginePCG64 = TRandomEngine<PCG64>;
+using RandomEngineXoshiro = TRandomEngine<Xoshiro256PlusPlus>;
+
+static_assert(sizeof(RandomEnginePCG64) == 24, "RandomEnginePCG64 should hold the 16-byte PCG64 state, the seed and the state counter only");
+static_assert(sizeof(RandomEngineXoshiro) == 40, "RandomEngineXoshiro should hold the 32-byte xoshiro256++ state, the seed and the state counter only");
+
+template <typename FBitGenerator>
+int32 TRandomEngine<FBitGenerator>::RandInt(const int32 Min, const int32 Max)
+{
+	std::uniform_int_distribution<int32> Distribution(Min, Max); // Inclusive range
+	GeneratedCount++;
+	return Distribution(Generator);
+}
+
+template <typename FBitGenerator>
+void TRandomEngine<FBitGenerator>::RandUInt32s(TArrayView<uint32> OutValues)
+{
+	for (uint32& Value : OutValues)
+	{
+		Value = Generator();
+	}
+	GeneratedCount += OutValues.Num();
+}
+
+template <typename FBitGenerator>
+float TRandomEngine<FBitGenerator>::RandFloat(const float Min, const float Max)
+{
+	std::uniform_real_distribution<float> Distribution(Min, Max); // Inclusive range
+	GeneratedCount++;
+	return Distribution(Generator);
+}
+
+template <typename FBitGenerator>
+void TRandomEngine<FBitGenerator>::RandFloats(TArrayView<float> OutValues, const float Min, const float Max)
+{
+	// Top 24 bits scaled to [0, 1), as RandomEngine::RandFloats does
+	const float Range = Max - Min;
+	for (float& Value : OutValues)
+	{
+		Value = Min + Range * (static_cast<float>(Generator() >> 8) * (1.0f / 16777216.0f));
+	}
+	GeneratedCount += OutValues.Num();
+}
+
+template <typename FBitGenerator>
+bool TRandomEngine<FBitGenerator>::RandBool(const float Probability)
+{
+	const float ClampedProbability = FMath::Clamp(Probability, 0.0f, 1.0f);
+	std::uniform_real_distribution<float> Distribution(0.0f, 1.0f);
+	GeneratedCount++;
+	return Distribution(Generator) < ClampedProbability;
+}
+
+template <typename FBitGenerator>
+float TRandomEngine<FBitGenerator>::RandGaussian(const float Mean, const float StdDev)
+{
+	std::normal_distribution<float> Distribution(Mean, StdDev);
+	GeneratedCount++;
+	return Distribution(Generator);
+}
+
+template <typename FBitGenerator>
+void TRandomEngine<FBitGenerator>::Discard(const uint32 Count)
+{
+	Generator.Inner.discard(Count);
+	GeneratedCount += Count;
+}
+
+template <typename FBitGenerator>
+void TRandomEngine<FBitGenerator>::JumpToState(const uint32 TargetState)
+{
+	if (TargetState == GeneratedCount)
+	{
+		return;
+	}
+	if (TargetState > GeneratedCount)
+	{
+		Advance(TargetState - GeneratedCount);
+	}
+	else
+	{
+		Reset();
+		Advance(TargetState);
+	}
+}
+
+template <typename FBitGenerator>
+void TRandomEngine<FBitGenerator>::Reset()
+{
+	Generator = FGenerator32(static_cast<uint32>(Seed));
+	GeneratedCount = 0;
+}
+
+template <typename FBitGenerator>
+void TRandomEngine<FBitGenerator>::Advance(const uint32 Steps)
+{
+	Generator.Inner.discard(Steps);
+	GeneratedCount += Steps;
+}